@@ -0,0 +1,169 @@
+#ifndef PATH_BENCH_GRAPH_GENERATORS_H
+#define PATH_BENCH_GRAPH_GENERATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/csr_graph.h"
+
+/**
+ * 基准测试用的合成图生成器。所有生成器都产生无向图 (每条边按两个方向各加一次)，边权为正整数，
+ * 返回的 CSRBuilder 可以直接赋给各个引擎的 pending 再 finalize / preprocess。
+ * 节点数 n 只是目标规模，网格类生成器会取最接近的 w * w。
+ * 有几何意义的生成器在 coords 非空时写出每个节点的坐标，供 Hilbert 曲线编号使用。
+ */
+
+using Coords = std::vector<std::pair<double, double>>;
+
+inline void add_undirected(CSRBuilder<int> &b, int u, int v, int c) {
+    b.add(u, v, c);
+    b.add(v, u, c);
+}
+
+/**
+ * @brief 4 邻接网格，边权在 [1, 100] 中均匀分布。
+ */
+inline CSRBuilder<int> make_grid(int n, std::mt19937 &rng, Coords *coords = nullptr) {
+    const int w = std::max(2, static_cast<int>(std::lround(std::sqrt(n))));
+    CSRBuilder<int> b(w * w);
+    if (coords) {
+        coords->resize(std::size_t(w) * w);
+        for (int u = 0; u < w * w; ++u) (*coords)[u] = {u % w, u / w};
+    }
+    std::uniform_int_distribution<int> cost(1, 100);
+    for (int r = 0; r < w; ++r)
+        for (int c = 0; c < w; ++c) {
+            int u = r * w + c;
+            if (c + 1 < w) add_undirected(b, u, u + 1, cost(rng));
+            if (r + 1 < w) add_undirected(b, u, u + w, cost(rng));
+        }
+    return b;
+}
+
+/**
+ * @brief 单位正方形中的随机几何图：距离不超过 r 的点对之间连边，r 取使平均度数约为 degree 的值，边权为欧氏距离。
+ *
+ * 用边长不小于 r 的格子划分平面，每个点只和相邻 3x3 个格子中的点比较，生成时间为 O(n * degree)。
+ */
+inline CSRBuilder<int> make_random_geometric(int n, std::mt19937 &rng, Coords *coords = nullptr, double degree = 6) {
+    constexpr double SCALE = 1e6;  // 距离换算成整数边权的比例
+    const double r = std::sqrt(degree / (std::numbers::pi * n));
+    const int cells = std::max(1, static_cast<int>(1 / r));
+    std::uniform_real_distribution<double> coord(0, 1);
+
+    // 按格子做计数排序：格子 k 中的点为 members[start[k] .. start[k + 1])
+    std::vector<double> x(n), y(n);
+    std::vector<int> cell_of(n), start(std::size_t(cells) * cells + 1, 0), members(n);
+    auto cell = [&](double v) { return std::min(cells - 1, static_cast<int>(v * cells)); };
+    for (int u = 0; u < n; ++u) {
+        x[u] = coord(rng), y[u] = coord(rng);
+        cell_of[u] = cell(y[u]) * cells + cell(x[u]);
+        ++start[cell_of[u] + 1];
+    }
+    for (std::size_t k = 0; k + 1 < start.size(); ++k) start[k + 1] += start[k];
+    std::vector<int> pos(start.begin(), start.end() - 1);
+    for (int u = 0; u < n; ++u) members[pos[cell_of[u]]++] = u;
+    if (coords) {
+        coords->resize(n);
+        for (int u = 0; u < n; ++u) (*coords)[u] = {x[u], y[u]};
+    }
+
+    CSRBuilder<int> b(n);
+    for (int u = 0; u < n; ++u) {
+        int cx = cell(x[u]), cy = cell(y[u]);
+        for (int gy = std::max(0, cy - 1); gy <= std::min(cells - 1, cy + 1); ++gy)
+            for (int gx = std::max(0, cx - 1); gx <= std::min(cells - 1, cx + 1); ++gx) {
+                int k = gy * cells + gx;
+                for (int i = start[k]; i < start[k + 1]; ++i) {
+                    int v = members[i];
+                    if (v <= u) continue;  // 每对点只处理一次
+                    double d = std::hypot(x[u] - x[v], y[u] - y[v]);
+                    if (d <= r) add_undirected(b, u, v, 1 + static_cast<int>(d * SCALE));
+                }
+            }
+    }
+    return b;
+}
+
+/**
+ * @brief Barabási–Albert 优先连接模型生成的幂律度分布图，每个新节点连向 m 个按度数比例抽取的已有节点。
+ */
+inline CSRBuilder<int> make_power_law(int n, std::mt19937 &rng, int m = 3) {
+    CSRBuilder<int> b(n);
+    std::uniform_int_distribution<int> cost(1, 100);
+    std::vector<int> ends;  // 每条边的两个端点各出现一次，均匀抽取即按度数比例抽取
+    const int core = std::min(n, m + 1);
+    for (int u = 0; u < core; ++u)
+        for (int v = u + 1; v < core; ++v) {
+            add_undirected(b, u, v, cost(rng));
+            ends.push_back(u), ends.push_back(v);
+        }
+
+    std::vector<int> picked;
+    for (int u = core; u < n; ++u) {
+        picked.clear();
+        while (static_cast<int>(picked.size()) < std::min(m, u)) {
+            int v = ends[std::uniform_int_distribution<std::size_t>(0, ends.size() - 1)(rng)];
+            if (std::find(picked.begin(), picked.end(), v) == picked.end()) picked.push_back(v);
+        }
+        for (int v : picked) {
+            add_undirected(b, u, v, cost(rng));
+            ends.push_back(u), ends.push_back(v);
+        }
+    }
+    return b;
+}
+
+/**
+ * @brief 类道路网：在抖动的网格上分三级道路，边权为行驶时间。
+ *
+ * 每 8 行 / 列为一条主干道，每 64 行 / 列为一条高速，二者总是连通且更快；其余为支路，以 15% 的概率缺失。
+ * 这样得到与真实路网相似的层次结构，CH 与 ALT 在其上的表现也接近真实路网。
+ */
+inline CSRBuilder<int> make_road_like(int n, std::mt19937 &rng, Coords *coords = nullptr) {
+    const int w = std::max(2, static_cast<int>(std::lround(std::sqrt(n))));
+    CSRBuilder<int> b(w * w);
+    std::uniform_real_distribution<double> jitter(-0.3, 0.3), keep(0, 1);
+
+    std::vector<double> x(std::size_t(w) * w), y(std::size_t(w) * w);
+    for (int r = 0; r < w; ++r)
+        for (int c = 0; c < w; ++c) x[r * w + c] = c + jitter(rng), y[r * w + c] = r + jitter(rng);
+    if (coords) {
+        coords->resize(x.size());
+        for (std::size_t u = 0; u < x.size(); ++u) (*coords)[u] = {x[u], y[u]};
+    }
+
+    // line 为道路所在的行号或列号
+    auto add_road = [&](int u, int v, int line) {
+        double slowness = line % 64 == 0 ? 1 : line % 8 == 0 ? 2 : 4;  // 单位长度的行驶时间
+        if (slowness == 4 && keep(rng) < 0.15) return;
+        double len = std::hypot(x[u] - x[v], y[u] - y[v]);
+        add_undirected(b, u, v, std::max(1, static_cast<int>(len * slowness * 100)));
+    };
+    for (int r = 0; r < w; ++r)
+        for (int c = 0; c < w; ++c) {
+            int u = r * w + c;
+            if (c + 1 < w) add_road(u, u + 1, r);
+            if (r + 1 < w) add_road(u, u + w, c);
+        }
+    return b;
+}
+
+/**
+ * @brief 按名字生成图，名字为 grid / geometric / powerlaw / road，未知名字返回空图。幂律图没有坐标，coords 保持为空。
+ */
+inline CSRBuilder<int> make_graph(const std::string &family, int n, std::mt19937 &rng, Coords *coords = nullptr) {
+    if (coords) coords->clear();
+    if (family == "grid") return make_grid(n, rng, coords);
+    if (family == "geometric") return make_random_geometric(n, rng, coords);
+    if (family == "powerlaw") return make_power_law(n, rng);
+    if (family == "road") return make_road_like(n, rng, coords);
+    return CSRBuilder<int>(0);
+}
+
+#endif
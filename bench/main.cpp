@@ -0,0 +1,541 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dijkstra/alt.h"
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/compressed_graph.h"
+#include "dijkstra/contraction_hierarchy.h"
+#include "dijkstra/hub_labels.h"
+#include "dijkstra/delta_stepping.h"
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/graph_loader.h"
+#include "dijkstra/multi_source.h"
+#include "dijkstra/multilevel_overlay.h"
+#include "dijkstra/reorder.h"
+#include "graph_generators.h"
+#include "perf_counters.h"
+#include "query_sets.h"
+
+/**
+ * shortpath_bench：在不同类型、不同规模的合成图上比较所有引擎和队列策略。
+ *
+ * 每个 (图类型, 规模) 先用参考 Dijkstra 生成按 rank 分桶的查询集，各引擎在计时前都要先对整个查询集
+ * 给出与参考实现相同的距离，任何不一致都会使程序以非零状态退出。
+ */
+
+static const char *USAGE = R"(usage: shortpath_bench [options]
+  --families=grid,geometric,powerlaw,road   图的类型
+  --sizes=1000,10000                        目标节点数，逗号分隔，最大 10000000
+  --engines=dijkstra,queues,bidir,ch,hl,alt,delta,matrix,overlay,compressed,load,reorder,multi
+  --skip=powerlaw:overlay                   跳过的 类型:引擎 组合，逗号分隔，--skip= 表示不跳过
+  --sources=16                              生成查询集的随机起点数
+  --min-rank=4                              最小的 rank 桶 2^k
+  --epochs=5                                nanobench 每项测量的 epoch 数
+  --seed=42
+  --json=FILE                               以 nanobench JSON 模板输出全部结果
+  --csv=FILE                                以 nanobench CSV 模板输出全部结果
+)";
+
+struct Options {
+    std::vector<std::string> families{"grid", "geometric", "powerlaw", "road"};
+    std::vector<std::string> sizes{"1000", "10000"};
+    std::vector<std::string> engines{"dijkstra", "queues", "bidir", "ch", "hl", "alt", "delta", "matrix",
+                                     "overlay", "compressed", "load", "reorder", "multi"};
+    // 幂律图没有小的割，覆盖图的单元几乎全是边界节点
+    std::vector<std::string> skip{"powerlaw:overlay"};
+    int sources = 16;
+    int min_rank = 4;
+    int epochs = 5;
+    unsigned seed = 42;
+    std::string json, csv;
+
+    bool has(const std::string &family, const std::string &engine) const {
+        return std::find(engines.begin(), engines.end(), engine) != engines.end() &&
+               std::find(skip.begin(), skip.end(), family + ":" + engine) == skip.end();
+    }
+
+    static std::vector<std::string> split(const std::string &s) {
+        std::vector<std::string> out;
+        std::istringstream in(s);
+        for (std::string item; std::getline(in, item, ',');)
+            if (!item.empty()) out.push_back(item);
+        return out;
+    }
+
+    /**
+     * @brief 解析 --key=value 形式的参数，遇到未知参数时返回 false。
+     */
+    bool parse(int argc, char **argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto eq = arg.find('=');
+            if (arg.rfind("--", 0) != 0 || eq == std::string::npos) return false;
+            std::string key = arg.substr(2, eq - 2), value = arg.substr(eq + 1);
+            if (key == "families") families = split(value);
+            else if (key == "sizes") sizes = split(value);
+            else if (key == "engines") engines = split(value);
+            else if (key == "skip") skip = split(value);
+            else if (key == "sources") sources = std::stoi(value);
+            else if (key == "min-rank") min_rank = std::stoi(value);
+            else if (key == "epochs") epochs = std::stoi(value);
+            else if (key == "seed") seed = std::stoul(value);
+            else if (key == "json") json = value;
+            else if (key == "csv") csv = value;
+            else return false;
+        }
+        return true;
+    }
+};
+
+template <typename F>
+double elapsed_ms(F &&f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 一个 (图类型, 规模) 上的所有测量共用的上下文。
+ */
+struct Runner {
+    ankerl::nanobench::Bench &bench;
+    const RankQueries &queries;
+    std::string prefix;  // 结果名前缀，如 "grid n=10000"
+    bool ok = true;
+
+    /**
+     * @brief 校验 dist(s, t) 与参考距离一致，然后对每个 rank 桶计时，结果按每个查询的耗时给出。
+     */
+    template <typename F>
+    void queries_by_rank(const std::string &engine, F &&dist) {
+        for (std::size_t k = 0; k < queries.buckets.size(); ++k) {
+            const auto &qs = queries.buckets[k];
+            if (qs.empty()) continue;
+            for (const auto &q : qs) {
+                if (int got = dist(q.s, q.t); got != q.dist) {
+                    std::fprintf(stderr, "%s / %s: dist(%d, %d) = %d, expected %d\n", prefix.c_str(), engine.c_str(),
+                                 q.s, q.t, got, q.dist);
+                    ok = false;
+                    return;
+                }
+            }
+            bench.batch(qs.size()).run(prefix + " / " + engine + " / rank 2^" + std::to_string(k), [&] {
+                long long sum = 0;
+                for (const auto &q : qs) sum += dist(q.s, q.t);
+                ankerl::nanobench::doNotOptimizeAway(sum);
+            });
+        }
+    }
+
+    template <typename F>
+    void once(const std::string &name, F &&f) {
+        bench.batch(1).run(prefix + " / " + name, f);
+    }
+};
+
+/**
+ * @brief 用队列策略 Q 计时全部查询，并输出所有查询中队列的最大长度。
+ */
+template <typename Q>
+void bench_queue(Runner &r, const CSRBuilder<int> &edges, const std::string &name) {
+    Dijkstra<int, std::uint32_t, PeakTrackingQueue<Q>> d(edges.n);
+    d.pending = edges;
+    d.finalize();
+    typename Dijkstra<int, std::uint32_t, PeakTrackingQueue<Q>>::Workspace ws;
+    r.queries_by_rank("Dijkstra<" + name + ">", [&](int s, int t) { return d.shortest_dist(s, t, ws); });
+    std::printf("# %s: Dijkstra<%s> peak heap size %zu\n", r.prefix.c_str(), name.c_str(), ws.pq.peak);
+}
+
+/**
+ * @brief 先随机打乱节点编号，模拟上游数据库给出的任意编号，再比较各种重新编号方式下的查询耗时和缓存未命中数。
+ * 查询仍使用打乱后的编号，由 Reordered 在接口处转换。
+ */
+void bench_reorder(Runner &r, const CSRBuilder<int> &edges, const Coords &coords, std::mt19937 &rng) {
+    const int n = edges.n;
+    std::vector<int> shuffle(n);  // 生成器的编号 -> 打乱后的编号
+    std::iota(shuffle.begin(), shuffle.end(), 0);
+    std::shuffle(shuffle.begin(), shuffle.end(), rng);
+    Dijkstra<int> shuffled(n);
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        shuffled.add_edge(shuffle[edges.src[i]], shuffle[edges.dst[i]], edges.cost[i]);
+    shuffled.finalize();
+
+    std::vector<std::pair<std::string, NodeOrder<>>> orders;
+    double ms = 0;
+    auto add = [&](const std::string &name, auto &&make) {
+        ms = elapsed_ms([&] { orders.emplace_back(name, make()); });
+        std::printf("# %s: %s order computed in %.0f ms\n", r.prefix.c_str(), name.c_str(), ms);
+    };
+    orders.emplace_back("shuffled", NodeOrder<>::identity(n));
+    add("bfs", [&] { return bfs_order(shuffled.g); });
+    add("dfs", [&] { return dfs_order(shuffled.g); });
+    add("rcm", [&] { return rcm_order(shuffled.g); });
+    if (!coords.empty()) {
+        Coords shuffled_coords(n);
+        for (int u = 0; u < n; ++u) shuffled_coords[shuffle[u]] = coords[u];
+        add("hilbert", [&] { return hilbert_order(shuffled_coords); });
+    }
+
+    CacheMissCounter counter;
+    const int s = shuffle[std::uniform_int_distribution<int>(0, n - 1)(rng)];
+    for (auto &[name, order] : orders) {
+        auto d = reorder(shuffled, std::move(order));
+        Dijkstra<int>::Workspace ws;
+        auto dist = [&](int u, int v) { return d.shortest_dist(shuffle[u], shuffle[v], ws); };
+        r.queries_by_rank("reorder " + name + " / shortest_dist", dist);
+        r.once("reorder " + name + " / dijkstra one-to-all",
+               [&] { ankerl::nanobench::doNotOptimizeAway(d.dijkstra(s, ws)); });
+        if (!counter.available()) continue;
+
+        std::size_t count = 0;
+        long long sum = 0;
+        auto query_misses = counter.count([&] {
+            for (const auto &bucket : r.queries.buckets)
+                for (const auto &q : bucket) sum += dist(q.s, q.t), ++count;
+        });
+        auto tree_misses = counter.count([&] { ankerl::nanobench::doNotOptimizeAway(d.dijkstra(s, ws)); });
+        ankerl::nanobench::doNotOptimizeAway(sum);
+        std::printf("# %s / reorder %s: %.0f cache misses per shortest_dist, %lld per dijkstra one-to-all\n",
+                    r.prefix.c_str(), name.c_str(), count ? double(query_misses) / count : 0.0,
+                    static_cast<long long>(tree_misses));
+    }
+    if (!counter.available()) std::printf("# cache-miss counter unavailable (perf_event_open failed)\n");
+}
+
+/**
+ * @brief 以 W 保存边权的压缩图：输出每条边的字节数，比较标量和 SSSE3 分组变长整数解码下 Dijkstra / BiDirDijkstra 的查询耗时。
+ * 边权无法用 W 精确保存时跳过。
+ */
+template <typename W>
+void bench_compressed(Runner &r, const Dijkstra<int> &ref, const BiDirDijkstra<int> &bidir, const std::string &name) {
+    using Packed = CompressedGraph<int, W>;
+    Packed g, gr;
+    try {
+        g = Packed(ref.g), gr = Packed(bidir.gr);
+    } catch (const std::invalid_argument &) {
+        std::printf("# %s: weights do not fit %s, skipped\n", r.prefix.c_str(), name.c_str());
+        return;
+    }
+    std::printf("# %s: %s %.2f bytes per edge\n", r.prefix.c_str(), name.c_str(),
+                double(g.memory_bytes()) / std::max<std::size_t>(1, g.edge_count()));
+    Dijkstra<int, std::uint32_t, DefaultQueue<int>, NoStats, Packed> d(g);
+    BiDirDijkstra<int, std::uint32_t, DefaultQueue<int>, NoStats, Packed> bd(g, gr);
+    for (bool simd : {false, true}) {
+        if (simd && !group_varint::ssse3_available()) continue;
+        d.g.use_simd = bd.g.use_simd = bd.gr.use_simd = simd;
+        auto label = name + (simd ? " ssse3" : " scalar");
+        typename decltype(d)::Workspace ws, fw, bw;
+        r.queries_by_rank("Dijkstra<" + label + ">", [&](int s, int t) { return d.shortest_dist(s, t, ws); });
+        r.queries_by_rank("BiDirDijkstra<" + label + ">", [&](int s, int t) { return bd.shortest_dist(s, t, fw, bw); });
+    }
+}
+
+/**
+ * @brief 单线程比较 16 个起点的一对全：逐个 Dijkstra::dijkstra 与按 K 个一批的 MultiSourceDijkstra (标量 / AVX2)。
+ */
+void bench_multi_source(Runner &r, Dijkstra<int> &ref, const CSRBuilder<int> &edges, std::mt19937 &rng) {
+    std::uniform_int_distribution<std::uint32_t> node(0, edges.n - 1);
+    std::vector<std::uint32_t> sources(16);
+    for (auto &s : sources) s = node(rng);
+    std::vector<std::vector<int>> expected;
+    for (int s : sources) expected.push_back(ref.dijkstra(s).dist);
+    r.once("16 sources one-to-all / Dijkstra::dijkstra loop", [&] {
+        for (int s : sources) ankerl::nanobench::doNotOptimizeAway(ref.dijkstra(s));
+    });
+
+    ThreadPool single(1);
+    auto run = [&](auto &ms, const std::string &name) {
+        for (bool simd : {false, true}) {
+            if (simd && !ms.simd_available()) continue;
+            ms.use_simd = simd;
+            auto label = "16 sources one-to-all / " + name + (simd ? " AVX2" : " scalar");
+            if (ms.distances(sources, single) != expected) {
+                std::fprintf(stderr, "%s / %s: distances differ from Dijkstra\n", r.prefix.c_str(), label.c_str());
+                r.ok = false;
+                return;
+            }
+            r.once(label, [&] { ankerl::nanobench::doNotOptimizeAway(ms.distances(sources, single)); });
+        }
+    };
+    MultiSourceDijkstra<int, 8> ms8(edges.n);
+    ms8.pending = edges;
+    run(ms8, "MultiSourceDijkstra<K=8>");
+    MultiSourceDijkstra<int, 16> ms16(edges.n);
+    ms16.pending = edges;
+    run(ms16, "MultiSourceDijkstra<K=16>");
+}
+
+bool bench_graph(const Options &opt, ankerl::nanobench::Bench &bench, const std::string &family, int size,
+                 std::mt19937 &rng) {
+    CSRBuilder<int> edges;
+    Coords coords;
+    double gen_ms = elapsed_ms([&] { edges = make_graph(family, size, rng, &coords); });
+    const int n = edges.n;
+    if (n == 0) {
+        std::fprintf(stderr, "unknown graph family: %s\n", family.c_str());
+        return false;
+    }
+    std::printf("# %s: %d nodes, %zu arcs, generated in %.0f ms\n", family.c_str(), n, edges.size(), gen_ms);
+
+    Dijkstra<int> ref(n);
+    ref.pending = edges;
+    ref.finalize();
+    auto queries = RankQueries::generate(ref, opt.sources, opt.min_rank, rng);
+    Runner r{bench, queries, family + " n=" + std::to_string(n)};
+
+    if (opt.has(family, "dijkstra")) {
+        Dijkstra<int>::Workspace ws;
+        r.queries_by_rank("Dijkstra", [&](int s, int t) { return ref.shortest_dist(s, t, ws); });
+
+        // 一条树边的边权在原值和变长之间交替：就地修复最短路径树与重新搜索整棵树
+        Dijkstra<int> dyn(ref.g);
+        int s = std::uniform_int_distribution<int>(0, n - 1)(rng), v = s;
+        std::vector<ShortestPathTree<int>> trees{dyn.dijkstra(s)};
+        for (int tries = 0; tries < 100 && v == s; ++tries) {
+            int x = std::uniform_int_distribution<int>(0, n - 1)(rng);
+            if (trees[0].reached(x)) v = x;
+        }
+        if (v != s) {
+            auto [c, u] = trees[0].prev[v];
+            bool flip = false;
+            r.once("edge update / update_edge repair",
+                   [&] { dyn.update_edge(u, v, (flip = !flip) ? 2 * c + 1 : c, trees); });
+            r.once("edge update / dijkstra rerun", [&] { ankerl::nanobench::doNotOptimizeAway(dyn.dijkstra(s)); });
+            if (trees[0].dist != dyn.dijkstra(s).dist) {
+                std::fprintf(stderr, "%s: repaired tree differs from Dijkstra\n", r.prefix.c_str());
+                r.ok = false;
+            }
+        }
+
+        // 等时圈：半径取离起点最近的 1% 节点中最远的距离，比较提前停止的 within 与完整搜索后过滤
+        auto full = ref.dijkstra(s);
+        std::vector<int> sorted;
+        for (int x = 0; x < n; ++x)
+            if (full.reached(x)) sorted.push_back(full.dist[x]);
+        std::sort(sorted.begin(), sorted.end());
+        int radius = sorted[std::min(sorted.size() - 1, std::size_t(n / 100))];
+        r.once("isochrone 1% / within", [&] { ankerl::nanobench::doNotOptimizeAway(ref.within(s, radius, ws)); });
+        r.once("isochrone 1% / dijkstra + filter", [&] {
+            auto tree = ref.dijkstra(s, ws);
+            std::vector<std::pair<int, int>> out;
+            for (int x = 0; x < n; ++x)
+                if (tree.reached(x) && tree.dist[x] <= radius) out.emplace_back(tree.dist[x], x);
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+    }
+
+    if (opt.has(family, "queues")) {
+        bench_queue<LazyBinaryHeap<int>>(r, edges, "lazy binary heap");
+        bench_queue<IndexedDaryHeap<int, 4>>(r, edges, "indexed 4-ary heap");
+        bench_queue<BucketQueue<int>>(r, edges, "dial buckets");
+        bench_queue<RadixHeap<int>>(r, edges, "radix heap");
+    }
+
+    if (opt.has(family, "bidir")) {
+        BiDirDijkstra<int> d(n);
+        d.pending = edges;
+        d.finalize();
+        BiDirDijkstra<int>::Workspace fw, bw;
+        r.queries_by_rank("BiDirDijkstra", [&](int s, int t) { return d.shortest_dist(s, t, fw, bw); });
+        d.concurrent = true;
+        r.queries_by_rank("BiDirDijkstra concurrent", [&](int s, int t) { return d.shortest_dist(s, t, fw, bw); });
+    }
+
+    if (opt.has(family, "compressed")) {
+        BiDirDijkstra<int> bd(n);
+        bd.pending = edges;
+        bd.finalize();
+        std::printf("# %s: CSRGraph %.2f bytes per edge\n", r.prefix.c_str(),
+                    double((n + 1) * sizeof(std::size_t) + ref.g.edge_count() * (sizeof(int) + sizeof(int))) /
+                        std::max<std::size_t>(1, ref.g.edge_count()));
+        Dijkstra<int>::Workspace ws;
+        BiDirDijkstra<int>::Workspace fw, bw;
+        r.queries_by_rank("Dijkstra<CSRGraph>", [&](int s, int t) { return ref.shortest_dist(s, t, ws); });
+        r.queries_by_rank("BiDirDijkstra<CSRGraph>", [&](int s, int t) { return bd.shortest_dist(s, t, fw, bw); });
+        bench_compressed<int>(r, ref, bd, "CompressedGraph<int>");
+        bench_compressed<std::uint16_t>(r, ref, bd, "CompressedGraph<uint16_t>");
+    }
+
+    if (opt.has(family, "ch")) {
+        ContractionHierarchy<int> ch(n);
+        ch.pending = edges;
+        double ms = elapsed_ms([&] { ch.preprocess(); });
+        std::printf("# %s: ContractionHierarchy preprocessing %.0f ms, %zu shortcuts, %d core nodes\n", r.prefix.c_str(),
+                    ms, ch.shortcut_count(), ch.core);
+        ContractionHierarchy<int>::Workspace fw, bw;
+        r.queries_by_rank("ContractionHierarchy", [&](int s, int t) { return ch.shortest_dist(s, t, fw, bw); });
+    }
+
+    if (opt.has(family, "hl")) {
+        ContractionHierarchy<int> ch(n);
+        ch.pending = edges;
+        ch.preprocess();
+        HubLabelStats st;
+        HubLabels<int> hl(n);
+        double ms = elapsed_ms([&] {
+            hl.g = ch.g;
+            st = hl.build(ch.g, ch.rank);
+        });
+        std::printf("# %s: HubLabels build %.0f ms, %.1f out / %.1f in labels per node, %.0f bytes per node\n",
+                    r.prefix.c_str(), ms, st.avg_out, st.avg_in, st.bytes_per_node);
+        r.queries_by_rank("HubLabels", [&](int s, int t) { return hl.shortest_dist(s, t); });
+    }
+
+    if (opt.has(family, "overlay")) {
+        MultilevelOverlay<int> mo(n);
+        mo.pending = edges;
+        double ms = elapsed_ms([&] { mo.preprocess(); });
+        std::size_t entries = 0;
+        for (const auto &level : mo.levels) entries += level.matrix.size();
+        std::printf("# %s: MultilevelOverlay preprocessing %.0f ms, %zu levels, %zu matrix entries\n",
+                    r.prefix.c_str(), ms, mo.levels.size(), entries);
+        MultilevelOverlay<int>::Workspace fw, bw;
+        r.queries_by_rank("MultilevelOverlay", [&](int s, int t) { return mo.shortest_dist(s, t, fw, bw); });
+
+        // 模拟路况更新：拓扑不变，边权在原值和随机放大之间交替，只计重新定制的时间
+        std::vector<int> original(mo.g.weights.begin(), mo.g.weights.end()), traffic = original;
+        for (auto &c : traffic) c += c * std::uniform_int_distribution<int>(0, 3)(rng) / 2;
+        ThreadPool single(1);
+        bool flip = false;
+        r.once("MultilevelOverlay customization / 1 thread", [&] {
+            mo.update_weights((flip = !flip) ? traffic : original, single);
+        });
+        r.once("MultilevelOverlay customization / " + std::to_string(default_thread_pool().size()) + " threads",
+               [&] { mo.update_weights((flip = !flip) ? traffic : original); });
+        mo.update_weights(original);
+    }
+
+    if (opt.has(family, "alt")) {
+        ALT<int> alt(n, 8);
+        for (std::size_t i = 0; i < edges.size(); ++i) alt.add_edge(edges.src[i], edges.dst[i], edges.cost[i]);
+        double ms = elapsed_ms([&] { alt.preprocess(); });
+        std::printf("# %s: ALT preprocessing %.0f ms, %zu landmarks\n", r.prefix.c_str(), ms, alt.landmarks.size());
+        ALT<int>::Workspace fw, bw;
+        r.queries_by_rank("ALT", [&](int s, int t) { return alt.shortest_dist(s, t, fw); });
+        r.queries_by_rank("bidirectional ALT", [&](int s, int t) { return alt.bidir_shortest_dist(s, t, fw, bw); });
+
+        // 所有查询平均每次确定的节点数，与不带势能的 Dijkstra / 双向 Dijkstra 比较
+        BiDirDijkstra<int> bd(n);
+        bd.pending = edges;
+        bd.finalize();
+        std::size_t queries = 0, settled[4] = {0, 0, 0, 0};
+        for (const auto &qs : r.queries.buckets)
+            for (const auto &q : qs) {
+                ++queries;
+                alt.fwd.shortest_dist(q.s, q.t, fw), settled[0] += fw.settled;
+                bd.shortest_dist(q.s, q.t, fw, bw), settled[1] += fw.settled + bw.settled;
+                alt.shortest_dist(q.s, q.t, fw), settled[2] += fw.settled;
+                alt.bidir_shortest_dist(q.s, q.t, fw, bw), settled[3] += fw.settled + bw.settled;
+            }
+        if (queries > 0)
+            std::printf("# %s: settled nodes per query: dijkstra %.0f, bidir %.0f, alt %.0f, bidir alt %.0f\n",
+                        r.prefix.c_str(), double(settled[0]) / queries, double(settled[1]) / queries,
+                        double(settled[2]) / queries, double(settled[3]) / queries);
+    }
+
+    if (opt.has(family, "delta")) {
+        int s = std::uniform_int_distribution<int>(0, n - 1)(rng);
+        Dijkstra<int>::Workspace ws;
+        ref.search(s, ref.NONE, ws);
+        r.once("one-to-all / Dijkstra::search", [&] { ref.search(s, ref.NONE, ws); });
+
+        DeltaStepping<int> ds(n);
+        ds.pending = edges;
+        ds.finalize();
+        auto got = ds.distances(s);
+        for (int v = 0; v < n; ++v)
+            if (got[v] != ws.get(v, ref.INF)) {
+                std::fprintf(stderr, "%s / DeltaStepping: wrong distance to %d\n", r.prefix.c_str(), v);
+                r.ok = false;
+                break;
+            }
+        const int hw = std::max(1u, std::thread::hardware_concurrency());
+        for (int t = 1; r.ok && t <= hw; t *= 2) {
+            ThreadPool pool(t);
+            r.once("one-to-all / DeltaStepping " + std::to_string(t) + " threads",
+                   [&] { ankerl::nanobench::doNotOptimizeAway(ds.distances(s, pool)); });
+        }
+    }
+
+    if (opt.has(family, "matrix")) {
+        std::uniform_int_distribution<std::uint32_t> node(0, n - 1);
+        std::vector<std::uint32_t> sources(16), targets(16);
+        for (auto &v : sources) v = node(rng);
+        for (auto &v : targets) v = node(rng);
+        Dijkstra<int>::Workspace ws;
+        r.once("16x16 matrix / shortest_dist loop", [&] {
+            std::vector<int> out;
+            for (int s : sources)
+                for (int t : targets) out.push_back(ref.shortest_dist(s, t, ws));
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+        r.once("16x16 matrix / distance_matrix",
+               [&] { ankerl::nanobench::doNotOptimizeAway(ref.distance_matrix(sources, targets)); });
+    }
+    if (opt.has(family, "load")) {
+        auto path = (std::filesystem::temp_directory_path() / "shortpath_bench.gr").string();
+        {
+            std::ofstream out(path);
+            out << "p sp " << n << ' ' << edges.size() << '\n';
+            for (std::size_t i = 0; i < edges.size(); ++i)
+                out << "a " << edges.src[i] + 1 << ' ' << edges.dst[i] + 1 << ' ' << edges.cost[i] << '\n';
+        }
+        auto expected = edges.build();
+        auto loaded = load_text_graph<int>(path, false);
+        if (!std::equal(loaded.forward.targets.begin(), loaded.forward.targets.end(), expected.targets.begin(),
+                        expected.targets.end())) {
+            std::fprintf(stderr, "%s / load_text_graph: graph differs from generator\n", r.prefix.c_str());
+            r.ok = false;
+        } else {
+            r.once("load .gr / read_dimacs + build", [&] {
+                std::ifstream in(path);
+                ankerl::nanobench::doNotOptimizeAway(read_dimacs<int>(in).build());
+            });
+            r.once("load .gr / load_text_graph",
+                   [&] { ankerl::nanobench::doNotOptimizeAway(load_text_graph<int>(path, false)); });
+        }
+        std::filesystem::remove(path);
+    }
+    if (opt.has(family, "reorder")) bench_reorder(r, edges, coords, rng);
+    if (opt.has(family, "multi")) bench_multi_source(r, ref, edges, rng);
+    return r.ok;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!opt.parse(argc, argv)) {
+        std::fputs(USAGE, stderr);
+        return 2;
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("shortpath").unit("query").warmup(1).epochs(opt.epochs).minEpochIterations(1);
+
+    std::mt19937 rng(opt.seed);
+    bool ok = true;
+    for (const auto &family : opt.families)
+        for (const auto &size : opt.sizes) ok = bench_graph(opt, bench, family, std::stoi(size), rng) && ok;
+
+    auto render = [&](const std::string &path, const char *tmpl) {
+        if (path.empty()) return;
+        std::ofstream out(path);
+        ankerl::nanobench::render(tmpl, bench, out);
+    };
+    render(opt.json, ankerl::nanobench::templates::json());
+    render(opt.csv, ankerl::nanobench::templates::csv());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#ifndef PATH_BENCH_PERF_COUNTERS_H
+#define PATH_BENCH_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief 当前线程的硬件缓存未命中计数 (Linux perf_event，末级缓存)。
+ *
+ * 没有权限或不在 Linux 上时 available() 为 false，count 返回 -1。
+ * nanobench 自带的计数器不包含缓存未命中，因此单独测量。
+ */
+struct CacheMissCounter {
+    int fd = -1;
+
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter &) = delete;
+    CacheMissCounter &operator=(const CacheMissCounter &) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    /**
+     * @brief 执行 f 并返回期间的缓存未命中次数。
+     */
+    template <typename F>
+    std::int64_t count(F &&f) {
+        if (!available()) {
+            f();
+            return -1;
+        }
+#ifdef __linux__
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        f();
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::int64_t value = -1;
+        if (read(fd, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+#else
+        return -1;
+#endif
+    }
+};
+
+#endif
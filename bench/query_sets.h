@@ -0,0 +1,53 @@
+#ifndef PATH_BENCH_QUERY_SETS_H
+#define PATH_BENCH_QUERY_SETS_H
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/dijkstra.h"
+
+/**
+ * @brief 按 Dijkstra rank 分桶的随机查询集。
+ *
+ * 从随机起点 s 做一次完整的 Dijkstra，第 2^k 个被确定的节点作为 rank 2^k 的终点，
+ * 因此同一个桶内的查询搜索空间相近，可以观察各引擎的耗时随查询“距离”的变化。
+ */
+struct RankQueries {
+    struct Query {
+        int s, t;
+        int dist;  // 参考距离，用于在计时前校验各引擎的结果
+    };
+
+    std::vector<std::vector<Query>> buckets;  // buckets[k] 为 rank 2^k 的查询
+
+    /**
+     * @param d 已加入所有边的参考引擎
+     * @param sources 起点个数，每个起点为每个桶贡献至多一个查询
+     * @param min_rank 只保留 k >= min_rank 的桶，过近的查询没有参考价值
+     */
+    static RankQueries generate(Dijkstra<int> &d, int sources, int min_rank, std::mt19937 &rng) {
+        RankQueries q;
+        if (d.n == 0) return q;
+        d.finalize();
+        std::uniform_int_distribution<int> node(0, d.n - 1);
+        Dijkstra<int>::Workspace ws;
+        for (int i = 0; i < sources; ++i) {
+            int s = node(rng);
+            long long rank = 0;
+            int k = 0;
+            d.search_until(s, ws, [&](int u) {
+                if (++rank != (1LL << k)) return false;
+                if (k >= min_rank) {
+                    if (q.buckets.size() <= std::size_t(k)) q.buckets.resize(k + 1);
+                    q.buckets[k].push_back({s, u, ws.dist[u]});
+                }
+                ++k;
+                return false;
+            });
+        }
+        return q;
+    }
+};
+
+#endif
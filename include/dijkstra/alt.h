@@ -0,0 +1,417 @@
+#ifndef PATH_ALT_H
+#define PATH_ALT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bidirectional_dijkstra.h"
+#include "dijkstra.h"
+#include "weight.h"
+#include "workspace.h"
+
+/**
+ * @brief 节点势能的缓存，与 SearchWorkspace 一样通过 generation 惰性重置。
+ *
+ * pruned[u] 为 1 表示根据地标距离可以断定 u 不可能位于 s 到 t 的路径上。
+ */
+template <typename T, NodeId V = std::uint32_t>
+struct PotentialCache {
+    std::vector<T> value;
+    std::vector<char> pruned;
+    std::vector<std::uint32_t> stamp;
+    std::uint32_t generation = 0;
+
+    void reset(V n) {
+        if (stamp.size() < static_cast<std::size_t>(n)) {
+            value.resize(n);
+            pruned.resize(n);
+            stamp.resize(n, 0);
+        }
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool cached(V u) const { return stamp[u] == generation; }
+
+    void set(V u, T v, bool p) {
+        stamp[u] = generation;
+        value[u] = v;
+        pruned[u] = p;
+    }
+};
+
+/**
+ * @brief ALT 算法 (A*, Landmarks, Triangle inequality)。
+ *
+ * 预处理选出 k 个地标并用 Dijkstra::search 计算每个地标到所有节点 (正向) 和所有节点到地标 (反向) 的距离，
+ * 查询时由三角不等式得到 d(v, t) 的下界作为 A* 的势能。势能是一致的 (consistent)，因此结果与 Dijkstra 完全相同。
+ * 地标距离表和查询结果都以 INF (即 infinity<T>()) 表示不可达。双向 A* 的反向键取势能的相反数，只支持有符号边权。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ * @tparam Q 优先队列策略，见 priority_queue.h
+ */
+template <Weight T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>>
+struct ALT {
+    using E = std::pair<T, V>;
+    using P = std::pair<T, std::vector<E>>;
+    using Workspace = SearchWorkspace<T, Q>;
+    static constexpr T INF = infinity<T>();
+    static constexpr V NONE = no_node<V>();
+
+    enum class Strategy {
+        Farthest,  // 每次选择离已有地标最远的节点
+        Avoid,     // avoid 启发式：选择当前下界最差的最短路径树子树中的叶子
+    };
+
+    V n;
+    int k;                       // 地标个数
+    Strategy strategy;
+    Dijkstra<T, V, Q> fwd, bwd;  // 正向图和反向图
+    std::vector<V> landmarks;
+    std::vector<T> from_lm;      // from_lm[v * k + i] = d(landmarks[i], v)，不可达为 INF
+    std::vector<T> to_lm;        // to_lm[v * k + i] = d(v, landmarks[i])
+    bool dirty = true;
+    unsigned seed = 1;
+
+    ALT(V N, int K = 8, Strategy S = Strategy::Farthest) : n(N), k(K), strategy(S), fwd(N), bwd(N) {}
+
+    bool check(V u) { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return;
+        fwd.add_edge(u, v, cost);
+        bwd.add_edge(v, u, cost);
+        dirty = true;
+    }
+
+    /**
+     * @brief 选取地标并计算地标距离。查询前会自动调用。
+     */
+    void preprocess() {
+        if (!dirty) return;
+        dirty = false;
+        fwd.finalize(), bwd.finalize();
+        landmarks.clear();
+        from_lm.assign(std::size_t(n) * k, INF);
+        to_lm.assign(std::size_t(n) * k, INF);
+        if (n == 0) return;
+
+        std::mt19937 rng(seed);
+        Workspace ws;
+        for (int i = 0; i < k && V(i) < n; ++i) {
+            V l = (strategy == Strategy::Avoid && i > 0) ? pick_avoid(rng, ws) : pick_farthest(rng, ws);
+            if (l == NONE) break;
+            landmarks.push_back(l);
+            fwd.search(l, NONE, ws);
+            for (V v = 0; v < n; ++v) from_lm[std::size_t(v) * k + i] = ws.get(v, INF);
+            bwd.search(l, NONE, ws);
+            for (V v = 0; v < n; ++v) to_lm[std::size_t(v) * k + i] = ws.get(v, INF);
+        }
+    }
+
+    /**
+     * @brief 由三角不等式得到 d(u, v) 的下界。
+     *
+     * 地标距离是饱和的 (超出类型范围即 infinity)，d(L, u) 有限而 d(L, v) 为 infinity 时只能得到下界
+     * infinity - d(L, u)，不能断定 v 不可达；下界达到 infinity 时任何 u 到 v 的路径都超出范围。
+     *
+     * @return (下界, 是否可以断定 v 从 u 不可达)
+     */
+    std::pair<T, bool> lower_bound(V u, V v) const {
+        T lb = 0;
+        const T *fu = &from_lm[std::size_t(u) * k], *fv = &from_lm[std::size_t(v) * k];
+        const T *tu = &to_lm[std::size_t(u) * k], *tv = &to_lm[std::size_t(v) * k];
+        for (std::size_t i = 0; i < landmarks.size(); ++i) {
+            // d(L, v) <= d(L, u) + d(u, v)；先比较再相减，无符号边权不会回绕
+            if (fu[i] != INF && fv[i] > fu[i] && fv[i] - fu[i] > lb) lb = fv[i] - fu[i];
+            // d(u, L) <= d(u, v) + d(v, L)
+            if (tv[i] != INF && tu[i] > tv[i] && tu[i] - tv[i] > lb) lb = tu[i] - tv[i];
+        }
+        return {lb, lb == INF};
+    }
+
+    /**
+     * @brief 单向 A* 求 s 到 t 的最短路径，返回值与 Dijkstra::shortest_path 相同。
+     */
+    P shortest_path(V s, V t, Workspace &ws) {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        preprocess();
+        if (!astar(s, t, ws)) return {INF, {}};
+
+        std::vector<E> path;
+        for (V cur = t; cur != NONE; cur = ws.prev[cur].second) path.emplace_back(ws.prev[cur].first, cur);
+        std::reverse(path.begin(), path.end());
+        return {ws.dist[t], path};
+    }
+
+    P shortest_path(V s, V t) { return shortest_path(s, t, thread_workspace<T, Q>()); }
+
+    T shortest_dist(V s, V t, Workspace &ws) {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        preprocess();
+        return astar(s, t, ws) ? ws.dist[t] : INF;
+    }
+
+    T shortest_dist(V s, V t) { return shortest_dist(s, t, thread_workspace<T, Q>()); }
+
+    /**
+     * @brief 双向 A*，使用平均势能 p_f = (pi_t - pi_s) / 2, p_r = -p_f，返回值与 BiDirDijkstra::shortest_path 相同。
+     */
+    P bidir_shortest_path(V s, V t, Workspace &fw, Workspace &bw)
+        requires std::is_signed_v<T>
+    {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        preprocess();
+        auto [estimate, meet] = bidir_astar(s, t, fw, bw);
+        if (estimate == INF) return {INF, {}};
+
+        auto [last_from, last_to, last_cost] = meet;
+        std::vector<E> path;
+        for (V cur = last_from; cur != NONE; cur = fw.prev[cur].second) path.emplace_back(fw.prev[cur].first, cur);
+        std::reverse(path.begin(), path.end());
+        path.emplace_back(last_cost, last_to);
+        for (V cur = last_to; bw.prev[cur].second != NONE; cur = bw.prev[cur].second)
+            path.emplace_back(bw.prev[cur].first, bw.prev[cur].second);
+        return {estimate, path};
+    }
+
+    P bidir_shortest_path(V s, V t)
+        requires std::is_signed_v<T>
+    {
+        return bidir_shortest_path(s, t, thread_workspace<T, Q, 0>(), thread_workspace<T, Q, 1>());
+    }
+
+    T bidir_shortest_dist(V s, V t, Workspace &fw, Workspace &bw)
+        requires std::is_signed_v<T>
+    {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        preprocess();
+        return bidir_astar(s, t, fw, bw).first;
+    }
+
+    T bidir_shortest_dist(V s, V t)
+        requires std::is_signed_v<T>
+    {
+        return bidir_shortest_dist(s, t, thread_workspace<T, Q, 0>(), thread_workspace<T, Q, 1>());
+    }
+
+    /**
+     * @brief 单向 A*，键为 d(v) + pi_t(v)。找到 t 时返回 true，ws 中保存距离和前驱。
+     */
+    bool astar(V s, V t, Workspace &ws) {
+        auto &pot = thread_potential_cache();
+        ws.reset(n);
+        pot.reset(n);
+        auto pi = [&](V v) {
+            if (!pot.cached(v)) {
+                auto [lb, pruned] = lower_bound(v, t);
+                pot.set(v, lb, pruned);
+            }
+            return pot.value[v];
+        };
+        pi(s);
+        if (pot.pruned[s]) return false;  // 地标距离表明 t 不可达
+
+        ws.set(s, 0, {0, NONE});
+        ws.pq.push(pi(s), s);
+        while (!ws.pq.empty()) {
+            auto [key, u] = ws.pq.top();
+            ws.pq.pop();
+            if (saturating_add(ws.dist[u], pot.value[u]) < key) continue;  // 过期元素
+            ++ws.settled;
+            if (u == t) return true;
+
+            for (const auto &[c, v] : fwd.g[u]) {
+                T nd = saturating_add(ws.dist[u], c);
+                if (!(nd < ws.get(v, INF))) continue;
+                T h = pi(v);
+                if (pot.pruned[v]) continue;
+                ws.set(v, nd, {c, u});
+                ws.pq.push(saturating_add(nd, h), v);
+            }
+        }
+        return false;
+    }
+
+    struct Meet {
+        V from, to;
+        T cost;
+    };
+
+    /**
+     * @brief 双向 A*。为了在整数边权下保持整数键，所有键都乘以 2：
+     * 正向键 2 d_f(v) + h(v)，反向键 2 d_r(v) - h(v)，其中 h(v) = pi_t(v) - pi_s(v)；
+     * 两侧最近出队的键之和不小于 2 * estimate 时停止。h 可能为负，因此要求 T 有符号。
+     * 势能是真实距离的下界，所以键不小于 d(v)，键和停止条件都用饱和加法计算；
+     * 整数边权的最短距离需小于类型上限的一半，否则乘 2 后饱和，结果不保证最短。不可达时距离为 INF。
+     */
+    std::pair<T, Meet> bidir_astar(V s, V t, Workspace &fw, Workspace &bw)
+        requires std::is_signed_v<T>
+    {
+        auto &pot = thread_potential_cache();
+        fw.reset(n), bw.reset(n);
+        pot.reset(n);
+        auto h = [&](V v) {
+            if (!pot.cached(v)) {
+                auto [to_t, pruned_t] = lower_bound(v, t);
+                auto [from_s, pruned_s] = lower_bound(s, v);
+                pot.set(v, to_t - from_s, pruned_t || pruned_s);
+            }
+            return pot.value[v];
+        };
+        auto key = [](T d, T sign_h) {  // 2 d + sign_h，饱和到 infinity
+            T twice = saturating_add(d, d);
+            return sign_h < 0 ? T(twice + sign_h) : saturating_add(twice, sign_h);
+        };
+        Meet meet{s, t, 0};
+        h(s), h(t);
+        if (pot.pruned[s] || pot.pruned[t]) return {INF, meet};
+
+        Workspace *ws[2] = {&fw, &bw};
+        const CSRGraph<T, V> *graph[2] = {&fwd.g, &bwd.g};
+        fw.set(s, 0, {0, NONE}), bw.set(t, 0, {0, NONE});
+        fw.pq.push(h(s), s);
+        bw.pq.push(-h(t), t);
+
+        T estimate = INF;
+        T top[2] = {0, 0};  // 两侧最近出队的键
+        while (!fw.pq.empty() && !bw.pq.empty()) {
+            for (int dir = 0; dir < 2; ++dir) {
+                auto &self = *ws[dir];
+                auto &other = *ws[dir ^ 1];
+                if (self.pq.empty()) break;
+                auto [top_key, u] = self.pq.top();
+                self.pq.pop();
+                T sign_h = dir ? -pot.value[u] : pot.value[u];
+                if (key(self.dist[u], sign_h) < top_key) continue;  // 过期元素
+                ++self.settled;
+                top[dir] = top_key;
+
+                for (const auto &[c, v] : (*graph[dir])[u]) {
+                    T nd = saturating_add(self.dist[u], c);
+                    if (!(nd < self.get(v, INF))) continue;
+                    T hv = h(v);
+                    if (pot.pruned[v]) continue;
+                    self.set(v, nd, {c, u});
+                    if (other.reached(v) && saturating_add(nd, other.dist[v]) < estimate) {
+                        estimate = saturating_add(nd, other.dist[v]);
+                        meet = dir ? Meet{v, u, c} : Meet{u, v, c};
+                    }
+                    self.pq.push(key(nd, dir ? -hv : hv), v);
+                }
+            }
+            if (estimate != INF && saturating_add(top[0], top[1]) >= saturating_add(estimate, estimate)) break;
+        }
+        return {estimate, meet};
+    }
+
+    static PotentialCache<T, V> &thread_potential_cache() {
+        thread_local PotentialCache<T, V> cache;
+        return cache;
+    }
+
+    /**
+     * @brief farthest 启发式：第一个地标取离随机节点最远的节点，之后取到已有地标最近距离最大的节点，
+     * 已有地标都无法到达的节点优先，以覆盖其他连通分量。
+     */
+    V pick_farthest(std::mt19937 &rng, Workspace &ws) {
+        std::vector<char> is_landmark(n, 0);
+        for (V l : landmarks) is_landmark[l] = 1;
+
+        std::vector<T> score(n, 0);
+        std::vector<char> covered(n, 0);
+        if (landmarks.empty()) {
+            fwd.search(V(rng() % n), NONE, ws);
+            for (V v = 0; v < n; ++v) {
+                covered[v] = ws.reached(v);
+                if (covered[v]) score[v] = ws.dist[v];
+            }
+        } else {
+            for (V v = 0; v < n; ++v) {
+                for (std::size_t i = 0; i < landmarks.size(); ++i) {
+                    T d = from_lm[std::size_t(v) * k + i];
+                    if (d == INF) continue;
+                    score[v] = covered[v] ? std::min(score[v], d) : d;
+                    covered[v] = 1;
+                }
+            }
+        }
+
+        V best = NONE;
+        for (V v = 0; v < n; ++v) {
+            if (is_landmark[v]) continue;
+            if (best == NONE || (covered[best] && !covered[v]) ||
+                (covered[best] == covered[v] && score[best] < score[v]))
+                best = v;
+        }
+        return best;
+    }
+
+    /**
+     * @brief avoid 启发式 (Goldberg & Werneck)：从随机根 r 建最短路径树，节点权重为 d(r, v) 与当前下界之差，
+     * 子树大小为子树权重之和 (子树中包含地标时为 0)，沿子树最大的孩子一直走到叶子作为新地标。
+     */
+    V pick_avoid(std::mt19937 &rng, Workspace &ws) {
+        V r = V(rng() % n);
+        fwd.search(r, NONE, ws);
+
+        std::vector<char> is_landmark(n, 0);
+        for (V l : landmarks) is_landmark[l] = 1;
+
+        // 最短路径树的孩子表 (CSR)
+        std::vector<std::size_t> child_off(std::size_t(n) + 1, 0);
+        std::vector<V> children;
+        for (V v = 0; v < n; ++v)
+            if (v != r && ws.reached(v)) ++child_off[ws.prev[v].second + 1];
+        for (V v = 0; v < n; ++v) child_off[v + 1] += child_off[v];
+        children.resize(child_off[n]);
+        std::vector<std::size_t> pos(child_off.begin(), child_off.end() - 1);
+        for (V v = 0; v < n; ++v)
+            if (v != r && ws.reached(v)) children[pos[ws.prev[v].second]++] = v;
+
+        // 后序遍历计算子树大小
+        std::vector<T> size(n, 0);
+        std::vector<char> has_landmark(n, 0);
+        std::vector<std::pair<V, bool>> stack{{r, false}};
+        while (!stack.empty()) {
+            auto [v, done] = stack.back();
+            stack.pop_back();
+            if (!done) {
+                stack.emplace_back(v, true);
+                for (auto i = child_off[v]; i < child_off[v + 1]; ++i) stack.emplace_back(children[i], false);
+                continue;
+            }
+            size[v] = ws.dist[v] - lower_bound(r, v).first;
+            has_landmark[v] = is_landmark[v];
+            for (auto i = child_off[v]; i < child_off[v + 1]; ++i) {
+                size[v] = saturating_add(size[v], size[children[i]]);
+                has_landmark[v] |= has_landmark[children[i]];
+            }
+            if (has_landmark[v]) size[v] = 0;
+        }
+
+        V v = r;
+        while (child_off[v] < child_off[v + 1]) {
+            V best = children[child_off[v]];
+            for (auto i = child_off[v]; i < child_off[v + 1]; ++i)
+                if (size[best] < size[children[i]]) best = children[i];
+            if (!(T(0) < size[best])) break;
+            v = best;
+        }
+        if (is_landmark[v] || v == r) return pick_farthest(rng, ws);
+        return v;
+    }
+};
+
+#endif
@@ -1,314 +1,543 @@
 #ifndef PATH_BIDIJKSTRA_H
 #define PATH_BIDIJKSTRA_H
-#include <doctest/doctest.h>
-#include <nanobench.h>
-#include <spdlog/spdlog.h>
 
 #include <algorithm>
-#include <queue>
-#include <set>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template <typename T>
+#include "compressed_graph.h"
+#include "connectivity.h"
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "shortest_path_tree.h"
+#include "thread_pool.h"
+#include "weight.h"
+#include "workspace.h"
+
+// V 为节点编号类型 (见 NodeId)，不可达的距离为 INF (即 infinity<T>())，起点的前驱为 NONE；
+// Q 为优先队列策略，见 priority_queue.h；S 为统计策略，见 stats.h，两个方向的统计分别记在各自的工作区中；
+// G 为图的表示，默认为 CSRGraph，内存受限时可以用 CompressedGraph (见 compressed_graph.h)
+template <Weight T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>, typename S = NoStats,
+          typename G = CSRGraph<T, V>>
 struct BiDirDijkstra {
-    using E = std::pair<T, int>;
+    static_assert(std::is_same_v<typename Q::node_type, V>, "queue node type must match V");
+    using E = std::pair<T, V>;
     using M = std::pair<T, std::vector<E>>;
-    const int INF = -1;
-
-    int n;
-    std::vector<std::vector<E>> g, gr;  // 有权有向图，利用gr作反向图
-    BiDirDijkstra(int N) : n(N), g(N), gr(n) {}
-
-    bool check(int u) { return u >= 0 && u < n; }
-
-    void add_edge(int u, int v, T cost) {
+    using Workspace = SearchWorkspace<T, Q, S>;
+    using Tree = ShortestPathTree<T, V>;
+    static constexpr T INF = infinity<T>();
+    static constexpr V NONE = no_node<V>();
+
+    V n;
+    G g, gr;                          // 有权有向图的邻接表，利用gr作反向图
+    CSRBuilder<T, V> pending;         // 尚未冻结的边
+    bool concurrent = false;          // 为 true 时 shortest_path / shortest_dist 在调用线程和一个常驻辅助线程上同时进行正反向搜索
+    ConnectivityIndex<V> reach;       // 正向图的可达性索引，由 finalize 建立
+    bool index_reachability = false;  // 为 true 时 finalize 建立可达性索引
+    BiDirDijkstra(V N) : n(N), g(N), gr(N), pending(N) {}
+    // 直接使用已有的正向图和反向图，如 map_csr_file 的结果
+    BiDirDijkstra(CSRGraph<T, V> forward, CSRGraph<T, V> reverse)
+        : n(forward.n), g(std::move(forward)), gr(std::move(reverse)), pending(n) {}
+    BiDirDijkstra(G forward, G reverse) requires(!std::is_same_v<G, CSRGraph<T, V>>)
+        : n(forward.n), g(std::move(forward)), gr(std::move(reverse)), pending(n) {}
+
+    bool check(V u) { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
         if (!check(u) || !check(v)) return;
-        g[u].emplace_back(cost, v);
-        gr[v].emplace_back(cost, u);
+        pending.add(u, v, cost);
+    }
+
+    /**
+     * @brief 将缓冲的边同时冻结为正向和反向 CSR 邻接表，并 (重新) 建立可达性索引，查询前会自动调用。
+     */
+    void finalize() {
+        if (!pending.empty()) {
+            merge_pending(g, pending);
+            merge_pending(gr, pending, true);
+            pending.clear();
+            reach = {};
+        }
+        if (index_reachability && reach.empty()) reach = ConnectivityIndex<V>(to_csr(g));
     }
-    std::vector<M> dijkstra(int s) {
+
+    /**
+     * @brief 可达性索引判定 t 不可达时返回 true，此时查询无需搜索。
+     */
+    bool unreachable(V s, V t) const { return !reach.empty() && !reach.reachable(s, t); }
+
+    /**
+     * @brief 从 s 出发的一对多最短路径：只做一次正向搜索，返回共享的最短路径树。
+     *
+     * @return 每个节点的距离和前驱，不可达为 INF；越界时返回空树
+     */
+    Tree dijkstra(V s, Workspace &ws) {
         if (!check(s)) return {};
-        std::vector<M> ans(n, {T(INF), {}});
+        finalize();
+        search_until(s, ws, [](V) { return false; });
+        [[maybe_unused]] auto timer = ws.stats.phase(Phase::Path);
+        return {s, n, ws};
+    }
 
-        for (int i = 0; i < n; i++) {
-            ans[i] = shortest_path(s, i);
+    Tree dijkstra(V s) { return dijkstra(s, thread_workspace<T, Q, 0, S>()); }
+
+    /**
+     * @brief 从 s 到 targets 中每个节点的最短路径，所有目标都确定后提前结束搜索。
+     *
+     * @return 与 targets 一一对应的 (最短路径长度, 路径)，越界或不可达为 {INF, {}}
+     */
+    std::vector<M> shortest_paths(V s, const std::vector<V> &targets, Workspace &ws) {
+        std::vector<M> ans(targets.size(), {INF, {}});
+        if (!check(s)) return ans;
+        finalize();
+
+        // 目标排序去重后二分查找，避免为标记目标额外分配 O(n) 的数组
+        std::vector<V> pending_targets;
+        for (V t : targets)
+            if (check(t)) pending_targets.push_back(t);
+        std::sort(pending_targets.begin(), pending_targets.end());
+        pending_targets.erase(std::unique(pending_targets.begin(), pending_targets.end()), pending_targets.end());
+
+        std::size_t remaining = pending_targets.size();
+        if (remaining > 0) {
+            search_until(s, ws, [&](V u) {
+                return std::binary_search(pending_targets.begin(), pending_targets.end(), u) && --remaining == 0;
+            });
         }
+
+        for (std::size_t i = 0; i < targets.size(); ++i)
+            if (check(targets[i])) ans[i] = extract(targets[i], ws);
         return ans;
     }
 
-    M shortest_path(int s, int t) {
-        if (!check(s) || !check(t)) return {T(INF), {}};                             // 检查越界
-        if (s == t) return {T(0), {{0, s}}};                                         // 起点和终点相同
-        std::vector<std::priority_queue<E, std::vector<E>, std::greater<E>>> pq(2);  // 正向和反向优先队列
-        std::vector<std::vector<T>> dist(2, std::vector<T>(n, T(INF)));  // 记录正向和反向最短路径长度
-        std::vector<std::vector<E>> prev(2, std::vector<E>(n, {T(INF), INF}));  // 记录cost和前驱节点
-
-        dist[0][s] = 0, dist[1][t] = 0;  // 起点和终点初始化为 0
-        prev[0][s] = {0, INF}, prev[1][t] = {0, INF};
-        pq[0].emplace(0, s);
-        pq[1].emplace(0, t);  // 起点和终点入队
-
-        bool ok = false;
-        T estimate = T(INF);
-        T tops = T(INF), topt = T(INF);
-        // 记录最佳路径最后扩展的边
-        int last_from = s, last_to = t, last_cost = 0;
+    std::vector<M> shortest_paths(V s, const std::vector<V> &targets) {
+        return shortest_paths(s, targets, thread_workspace<T, Q, 0, S>());
+    }
 
-        while (!pq[0].empty() && !pq[1].empty()) {
-            {
-                auto [cur_dist, cur_node] = pq[0].top();
-                pq[0].pop();
+    /**
+     * @brief 正向单向搜索，每确定一个节点 u 调用一次 stop(u)，返回 true 时提前退出。
+     */
+    template <typename Stop>
+    void search_until(V s, Workspace &ws, Stop &&stop) {
+        {
+            [[maybe_unused]] auto timer = ws.stats.phase(Phase::Init);
+            ws.reset(n);
+            ws.set(s, 0, {0, NONE});
+            ws.pq.push(0, s);
+            ws.stats.on_push();
+        }
 
-                spdlog::debug("forward origin: ({}, {})", cur_dist, cur_node);
+        [[maybe_unused]] auto timer = ws.stats.phase(Phase::Search);
+        while (!ws.pq.empty()) {
+            auto [cur_dist, cur_node] = ws.pq.top();
+            ws.pq.pop();
+
+            bool stale = ws.dist[cur_node] < cur_dist;
+            ws.stats.on_pop(stale);
+            if (stale) continue;
+            ++ws.settled;
+            ws.stats.on_settle();
+            if (stop(cur_node)) break;
+
+            for (const auto& [cost, next_node] : g[cur_node]) {
+                ws.stats.on_scan();
+                T cand = saturating_add(cur_dist, cost);
+                if (cand < ws.get(next_node, infinity<T>())) {
+                    ws.set(next_node, cand, {cost, cur_node});
+                    ws.pq.push(cand, next_node);
+                    ws.stats.on_relax();
+                    ws.stats.on_push();
+                }
+            }
+        }
+    }
 
-                if (dist[0][cur_node] < cur_dist) continue;
+    /**
+     * @brief 沿正向搜索的前驱树回溯出到 v 的路径。
+     */
+    M extract(V v, const Workspace &ws) const {
+        if (!ws.reached(v)) return {INF, {}};  // 不可达
+        std::vector<E> path;
+        for (V cur = v; cur != NONE; cur = ws.prev[cur].second) path.emplace_back(ws.prev[cur].first, cur);
+        std::reverse(path.begin(), path.end());
+        return {ws.dist[v], path};
+    }
 
-                tops = cur_dist;
-                for (const auto& [cost, next_node] : g[cur_node]) {
-                    // 松弛操作
-                    if (dist[0][next_node] == T(INF) || cur_dist + cost < dist[0][next_node]) {
-                        dist[0][next_node] = cur_dist + cost;
-                        prev[0][next_node] = {cost, cur_node};  // 记录前驱节点
-
-                        // 计算uv_cost，避免在dist[1][next_node]为INF时进行不必要的加法操作
-                        T uv_cost =
-                            (dist[1][next_node] == T(INF)) ? T(INF) : dist[0][cur_node] + dist[1][next_node] + cost;
-                        // 更新estimate
-                        if (uv_cost != T(INF)) {
-                            if (estimate == T(INF) || uv_cost < estimate) {
-                                estimate = uv_cost;
-                                // 记录更新estimate时扩展的边
-                                last_from = cur_node, last_to = next_node, last_cost = cost;
-                                spdlog::debug("estimate: {}, update by: ({}, {})", estimate, cur_node, next_node);
+    /**
+     * @brief 双向 Dijkstra 求 s 到 t 的最短路径。
+     *
+     * @param fw 正向搜索的工作区
+     * @param bw 反向搜索的工作区
+     */
+    M shortest_path(V s, V t, Workspace &fw, Workspace &bw) {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        finalize();
+        if (unreachable(s, t)) {  // 索引判定不可达，清空工作区后直接返回
+            fw.reset(n), bw.reset(n);
+            return {INF, {}};
+        }
+        if (concurrent) {
+            V from, to;
+            T cost;
+            T estimate = concurrent_search(s, t, fw, bw, from, to, cost);
+            if (estimate == INF) return {INF, {}};
+            [[maybe_unused]] auto timer = fw.stats.phase(Phase::Path);
+            return {estimate, join_path(from, to, cost, fw, bw)};
+        }
+        Workspace *ws[2] = {&fw, &bw};  // 正向和反向工作区，包含优先队列、距离和前驱
+
+        {
+            [[maybe_unused]] auto timer = fw.stats.phase(Phase::Init);
+            fw.reset(n), bw.reset(n);
+            fw.set(s, 0, {0, NONE}), bw.set(t, 0, {0, NONE});  // 起点和终点初始化为 0
+            fw.pq.push(0, s);
+            bw.pq.push(0, t);  // 起点和终点入队
+            fw.stats.on_push(), bw.stats.on_push();
+        }
+
+        T estimate = INF;  // 尚未相遇
+        T tops = INF, topt = INF;
+        // 记录最佳路径最后扩展的边
+        V last_from = s, last_to = t;
+        T last_cost = 0;
+
+        {
+            [[maybe_unused]] auto timer = fw.stats.phase(Phase::Search);
+            while (!ws[0]->pq.empty() && !ws[1]->pq.empty()) {
+                {
+                    auto [cur_dist, cur_node] = ws[0]->pq.top();
+                    ws[0]->pq.pop();
+
+                    bool stale = ws[0]->dist[cur_node] < cur_dist;
+                    ws[0]->stats.on_pop(stale);
+                    if (stale) continue;
+                    ++ws[0]->settled;
+                    ws[0]->stats.on_settle();
+
+                    tops = cur_dist;
+                    for (const auto& [cost, next_node] : g[cur_node]) {
+                        ws[0]->stats.on_scan();
+                        // 松弛操作
+                        T cand = saturating_add(cur_dist, cost);
+                        if (cand < ws[0]->get(next_node, infinity<T>())) {
+                            ws[0]->set(next_node, cand, {cost, cur_node});  // 记录前驱节点
+                            ws[0]->stats.on_relax();
+
+                            // 反向搜索已到达 next_node 时才计算uv_cost
+                            if (ws[1]->reached(next_node)) {
+                                T uv_cost = saturating_add(cand, ws[1]->dist[next_node]);
+                                // 更新estimate
+                                if (uv_cost < estimate) {
+                                    estimate = uv_cost;
+                                    // 记录更新estimate时扩展的边
+                                    last_from = cur_node, last_to = next_node, last_cost = cost;
+                                    ws[0]->stats.on_meet();
+                                }
                             }
-                        }
 
-                        pq[0].emplace(dist[0][next_node], next_node);
-                        spdlog::debug("forward add: ({}, {})", dist[0][next_node], next_node);
+                            ws[0]->pq.push(cand, next_node);
+                            ws[0]->stats.on_push();
+                        }
                     }
                 }
-            }
-
-            {
-                auto [cur_dist, cur_node] = pq[1].top();
-                pq[1].pop();
-                spdlog::debug("backward origin: ({}, {})", cur_dist, cur_node);
 
-                if (dist[1][cur_node] < cur_dist) continue;
-                topt = cur_dist;
-                for (const auto& [cost, next_node] : gr[cur_node]) {
-                    if (dist[1][next_node] == T(INF) || cur_dist + cost < dist[1][next_node]) {
-                        dist[1][next_node] = cur_dist + cost;
-                        prev[1][next_node] = {cost, cur_node};
-
-                        // 计算uv_cost，避免在dist[0][to]为INF时进行不必要的加法操作
-                        T uv_cost =
-                            (dist[0][next_node] == T(INF)) ? T(INF) : dist[1][cur_node] + dist[0][next_node] + cost;
-                        // 更新estimate
-                        if (uv_cost != T(INF)) {
-                            if (estimate == T(INF) || uv_cost < estimate) {
-                                estimate = uv_cost;
-                                // 记录更新estimate时扩展的边
-                                last_from = next_node, last_to = cur_node, last_cost = cost;
-                                spdlog::debug("estimate: {}, update by: ({}, {})", estimate, cur_node, next_node);
+                {
+                    auto [cur_dist, cur_node] = ws[1]->pq.top();
+                    ws[1]->pq.pop();
+
+                    bool stale = ws[1]->dist[cur_node] < cur_dist;
+                    ws[1]->stats.on_pop(stale);
+                    if (stale) continue;
+                    ++ws[1]->settled;
+                    ws[1]->stats.on_settle();
+                    topt = cur_dist;
+                    for (const auto& [cost, next_node] : gr[cur_node]) {
+                        ws[1]->stats.on_scan();
+                        T cand = saturating_add(cur_dist, cost);
+                        if (cand < ws[1]->get(next_node, infinity<T>())) {
+                            ws[1]->set(next_node, cand, {cost, cur_node});
+                            ws[1]->stats.on_relax();
+
+                            // 正向搜索已到达 next_node 时才计算uv_cost
+                            if (ws[0]->reached(next_node)) {
+                                T uv_cost = saturating_add(cand, ws[0]->dist[next_node]);
+                                // 更新estimate
+                                if (uv_cost < estimate) {
+                                    estimate = uv_cost;
+                                    // 记录更新estimate时扩展的边
+                                    last_from = next_node, last_to = cur_node, last_cost = cost;
+                                    ws[1]->stats.on_meet();
+                                }
                             }
+                            ws[1]->pq.push(cand, next_node);
+                            ws[1]->stats.on_push();
                         }
-                        pq[1].emplace(dist[1][next_node], next_node);
-                        spdlog::debug("backward add: ({}, {})", dist[1][next_node], next_node);
                     }
                 }
-            }
 
-            if (estimate != T(INF) && tops + topt >= estimate) break;
+                if (saturating_add(tops, topt) >= estimate) break;
+            }
         }
 
-        if (estimate == T(INF)) return {estimate, {}};  // 未找到路径
+        if (estimate == INF) return {INF, {}};  // 未找到路径
 
+        [[maybe_unused]] auto timer = fw.stats.phase(Phase::Path);
+        return {estimate, join_path(last_from, last_to, last_cost, fw, bw)};
+    }
+
+    /**
+     * @brief 由相遇边 (from, to, cost) 拼接路径：正向前驱树回溯到 from，再沿反向前驱树从 to 走到终点。
+     */
+    std::vector<E> join_path(V from, V to, T cost, const Workspace &fw, const Workspace &bw) const {
         std::vector<E> path;
         // 前向搜索回溯路径
-        auto cur = last_from;
-        while (cur != INF) {
-            path.emplace_back(prev[0][cur].first, cur);
-            cur = prev[0][cur].second;
+        auto cur = from;
+        while (cur != NONE) {
+            path.emplace_back(fw.prev[cur].first, cur);
+            cur = fw.prev[cur].second;
         }
         std::reverse(path.begin(), path.end());
 
-        // // 添加last_cost, last_to的边和权重
-        path.emplace_back(last_cost, last_to);
+        // 添加相遇边
+        path.emplace_back(cost, to);
 
         // 后向搜索路径
-        auto rev_cur = last_to;
-        while (prev[1][rev_cur].second != INF) {  // 下一个节点不是INF
-            path.emplace_back(prev[1][rev_cur].first, prev[1][rev_cur].second);
-            rev_cur = prev[1][rev_cur].second;
+        auto rev_cur = to;
+        while (bw.prev[rev_cur].second != NONE) {  // 下一个节点不是NONE
+            path.emplace_back(bw.prev[rev_cur].first, bw.prev[rev_cur].second);
+            rev_cur = bw.prev[rev_cur].second;
         }
-
-        return {estimate, path};
+        return path;
     }
 
-    T shortest_dist(int s, int t) {
-        if (!check(s) || !check(t)) return T(INF);                                   // 检查越界
-        if (s == t) return T(0);                                                     // 起点和终点相同
-        std::vector<std::priority_queue<E, std::vector<E>, std::greater<E>>> pq(2);  // 正向和反向优先队列
-        std::vector<std::vector<T>> dist(2, std::vector<T>(n, T(INF)));  // 记录正向和反向最短路径长度
+    M shortest_path(V s, V t) {
+        return shortest_path(s, t, thread_workspace<T, Q, 0, S>(), thread_workspace<T, Q, 1, S>());
+    }
 
-        dist[0][s] = 0, dist[1][t] = 0;  // 起点和终点初始化为 0
-        pq[0].emplace(0, s);
-        pq[1].emplace(0, t);  // 起点和终点入队
+    T shortest_dist(V s, V t, Workspace &fw, Workspace &bw) {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        finalize();
+        if (unreachable(s, t)) {
+            fw.reset(n), bw.reset(n);
+            return INF;
+        }
+        if (concurrent) {
+            V from, to;
+            T cost;
+            return concurrent_search(s, t, fw, bw, from, to, cost);
+        }
+        Workspace *ws[2] = {&fw, &bw};  // 正向和反向工作区
+
+        {
+            [[maybe_unused]] auto timer = fw.stats.phase(Phase::Init);
+            fw.reset(n), bw.reset(n);
+            fw.set(s, 0), bw.set(t, 0);  // 起点和终点初始化为 0
+            fw.pq.push(0, s);
+            bw.pq.push(0, t);  // 起点和终点入队
+            fw.stats.on_push(), bw.stats.on_push();
+        }
 
-        bool ok = false;
-        T estimate = T(INF);
-        T tops = T(INF), topt = T(INF);
+        T estimate = INF;  // 尚未相遇
+        T tops = INF, topt = INF;
 
-        while (!pq[0].empty() && !pq[1].empty()) {
+        [[maybe_unused]] auto timer = fw.stats.phase(Phase::Search);
+        while (!ws[0]->pq.empty() && !ws[1]->pq.empty()) {
             {
-                auto [cur_dist, cur_node] = pq[0].top();
-                pq[0].pop();
+                auto [cur_dist, cur_node] = ws[0]->pq.top();
+                ws[0]->pq.pop();
 
-                if (dist[0][cur_node] < cur_dist) continue;
+                bool stale = ws[0]->dist[cur_node] < cur_dist;
+                ws[0]->stats.on_pop(stale);
+                if (stale) continue;
+                ++ws[0]->settled;
+                ws[0]->stats.on_settle();
 
                 tops = cur_dist;
                 for (const auto& [cost, next_node] : g[cur_node]) {
+                    ws[0]->stats.on_scan();
                     // 松弛操作
-                    if (dist[0][next_node] == T(INF) || cur_dist + cost < dist[0][next_node]) {
-                        dist[0][next_node] = cur_dist + cost;
-
-                        // 计算uv_cost，避免在dist[1][next_node]为INF时进行不必要的加法操作
-                        T uv_cost =
-                            (dist[1][next_node] == T(INF)) ? T(INF) : dist[0][cur_node] + dist[1][next_node] + cost;
-                        // 更新estimate
-                        if (uv_cost != T(INF)) {
-                            if (estimate == T(INF) || uv_cost < estimate) {
+                    T cand = saturating_add(cur_dist, cost);
+                    if (cand < ws[0]->get(next_node, infinity<T>())) {
+                        ws[0]->set(next_node, cand);
+                        ws[0]->stats.on_relax();
+
+                        // 反向搜索已到达 next_node 时才计算uv_cost
+                        if (ws[1]->reached(next_node)) {
+                            T uv_cost = saturating_add(cand, ws[1]->dist[next_node]);
+                            // 更新estimate
+                            if (uv_cost < estimate) {
                                 estimate = uv_cost;
+                                ws[0]->stats.on_meet();
                             }
                         }
 
-                        pq[0].emplace(dist[0][next_node], next_node);
+                        ws[0]->pq.push(cand, next_node);
+                        ws[0]->stats.on_push();
                     }
                 }
             }
 
             {
-                auto [cur_dist, cur_node] = pq[1].top();
-                pq[1].pop();
-
-                if (dist[1][cur_node] < cur_dist) continue;
+                auto [cur_dist, cur_node] = ws[1]->pq.top();
+                ws[1]->pq.pop();
+
+                bool stale = ws[1]->dist[cur_node] < cur_dist;
+                ws[1]->stats.on_pop(stale);
+                if (stale) continue;
+                ++ws[1]->settled;
+                ws[1]->stats.on_settle();
                 topt = cur_dist;
                 for (const auto& [cost, next_node] : gr[cur_node]) {
-                    if (dist[1][next_node] == T(INF) || cur_dist + cost < dist[1][next_node]) {
-                        dist[1][next_node] = cur_dist + cost;
-
-                        // 计算uv_cost，避免在dist[0][to]为INF时进行不必要的加法操作
-                        T uv_cost =
-                            (dist[0][next_node] == T(INF)) ? T(INF) : dist[1][cur_node] + dist[0][next_node] + cost;
-                        // 更新estimate
-                        if (uv_cost != T(INF)) {
-                            if (estimate == T(INF) || uv_cost < estimate) {
+                    ws[1]->stats.on_scan();
+                    T cand = saturating_add(cur_dist, cost);
+                    if (cand < ws[1]->get(next_node, infinity<T>())) {
+                        ws[1]->set(next_node, cand);
+                        ws[1]->stats.on_relax();
+
+                        // 正向搜索已到达 next_node 时才计算uv_cost
+                        if (ws[0]->reached(next_node)) {
+                            T uv_cost = saturating_add(cand, ws[0]->dist[next_node]);
+                            // 更新estimate
+                            if (uv_cost < estimate) {
                                 estimate = uv_cost;
+                                ws[1]->stats.on_meet();
                             }
                         }
-                        pq[1].emplace(dist[1][next_node], next_node);
+                        ws[1]->pq.push(cand, next_node);
+                        ws[1]->stats.on_push();
                     }
                 }
             }
 
-            if (estimate != T(INF) && tops + topt >= estimate) break;
+            if (saturating_add(tops, topt) >= estimate) break;
         }
 
         return estimate;
     }
-};
 
-TEST_CASE("BiDijkstraTest1") {
-    BiDirDijkstra<int> d(8);
-    d.add_edge(0, 1, 2);
-    d.add_edge(0, 2, 6);
-    d.add_edge(1, 3, 5);
-    d.add_edge(2, 3, 8);
-    d.add_edge(3, 4, 10);
-    d.add_edge(3, 5, 15);
-    d.add_edge(4, 5, 3);
-    d.add_edge(4, 6, 2);
-    d.add_edge(5, 6, 6);
-
-    SUBCASE("起点终点之间有边") {
-        auto ans = d.shortest_path(0, 5);
-        CHECK(ans.first == 20);
-    }
-    SUBCASE("起点终点之间没有边") {
-        auto ans = d.shortest_path(0, 7);
-        CHECK(ans.first == -1);
-    }
-    SUBCASE("起点终点越界") {
-        auto ans = d.shortest_path(0, 9);
-        CHECK(ans.first == -1);
-    }
-    SUBCASE("起点终点相同") {
-        auto ans = d.shortest_path(0, 0);
-        CHECK(ans.first == 0);
+    T shortest_dist(V s, V t) { return shortest_dist(s, t, thread_workspace<T, Q, 0, S>(), thread_workspace<T, Q, 1, S>()); }
+
+    /**
+     * @brief 并发双向搜索中两个线程共享的状态。
+     */
+    struct Meeting {
+        std::atomic<T> estimate{infinity<T>()};              // 当前最佳路径长度，只减不增
+        std::atomic<T> top[2]{infinity<T>(), infinity<T>()};  // 两个方向最近出队的距离，infinity 表示尚未出队
+        std::atomic<bool> done{false};
+        std::mutex lock;                         // 保护 estimate 的更新和相遇边
+        V from = NONE, to = NONE;
+        T cost = 0;
+
+        /**
+         * @brief 用经过相遇边 (u, v, c) 的路径长度 cand 尝试更新 estimate，成功时返回 true。
+         */
+        bool improve(T cand, V u, V v, T c) {
+            T est = estimate.load(std::memory_order_relaxed);
+            if (!(cand < est)) return false;
+            std::lock_guard guard(lock);
+            est = estimate.load(std::memory_order_relaxed);
+            if (!(cand < est)) return false;
+            from = u, to = v, cost = c;
+            estimate.store(cand, std::memory_order_relaxed);
+            return true;
+        }
+    };
+
+    /**
+     * @brief 并发搜索使用的线程池：调用线程加一个常驻的辅助线程。每个调用线程第一次并发查询时创建一次，
+     * 之后的查询复用，不再为每次查询创建线程；不同调用线程互不共享，可以同时查询。
+     */
+    static ThreadPool &helper_pool() {
+        thread_local ThreadPool pool(2);
+        return pool;
     }
-    SUBCASE("所有结果") {
-        std::vector<std::pair<int, std::vector<std::pair<int, int>>>> except_paths = {
-            {0, {{0, 0}}},
-            {2, {{0, 0}, {2, 1}}},
-            {6, {{0, 0}, {6, 2}}},
-            {7, {{0, 0}, {2, 1}, {5, 3}}},
-            {17, {{0, 0}, {2, 1}, {5, 3}, {10, 4}}},
-            {20, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}}},
-            {19, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {2, 6}}},
-            {-1, {}},
-        };
-
-        auto short_paths = d.dijkstra(0);
-        CHECK(short_paths == except_paths);
+
+    /**
+     * @brief 正向搜索在调用线程、反向搜索在 helper_pool 的辅助线程上同时进行，共享 estimate 和相遇边。
+     *
+     * 每个方向出队一个节点后，先检查 “本方向的出队距离 + 另一方向最近的出队距离 >= estimate”，
+     * 然后用一次 seq_cst 栅栏把之前写入的距离与之后对另一方向距离的读取隔开，再扫描它的所有出边，
+     * 无论松弛是否成功都检查另一端是否已被另一方向到达。对最短路径上正向已扫描的 u 与反向已扫描的 v
+     * 相连的边 (u, v)，两个栅栏之中较晚的一方一定能读到另一方的最终距离，因此停止条件仍然正确。
+     * 出队距离以 release 发布、以 acquire 读取，读到它的线程也能看到另一方向在此之前对 estimate 的更新。
+     * 每次查询只需唤醒辅助线程 (微秒量级)；辅助线程来不及开始时调用线程会先后执行两个方向，
+     * 此时正向搜索单独搜到终点后结束，反向搜索立即退出。没有空闲核时会退化为接近单向的搜索。
+     *
+     * @return 最短路径长度，不可达为 INF；from / to / cost 为最佳路径经过的相遇边
+     */
+    T concurrent_search(V s, V t, Workspace &fw, Workspace &bw, V &from, V &to, T &cost) {
+        {
+            [[maybe_unused]] auto timer = fw.stats.phase(Phase::Init);
+            fw.reset(n), bw.reset(n);
+            fw.set(s, 0, {0, NONE}), bw.set(t, 0, {0, NONE});
+            fw.pq.push(0, s);
+            bw.pq.push(0, t);
+            fw.stats.on_push(), bw.stats.on_push();
+        }
+
+        Meeting meet;
+        helper_pool().parallel_for(2, [&](std::size_t dir, int) {
+            if (dir == 0) search_direction<0>(fw, bw, meet);
+            else search_direction<1>(bw, fw, meet);
+        });
+
+        from = meet.from, to = meet.to, cost = meet.cost;
+        return meet.estimate.load(std::memory_order_relaxed);
     }
-}
-
-TEST_CASE("DijkstraTest2") {
-    BiDirDijkstra<int> d(9);
-    d.add_edge(0, 1, 1);
-    d.add_edge(0, 5, 4);
-    d.add_edge(0, 4, 8);
-    d.add_edge(1, 2, 1);
-    d.add_edge(2, 3, 1);
-    d.add_edge(3, 7, 1);
-    d.add_edge(7, 8, 2);
-    d.add_edge(5, 8, 1);
-    d.add_edge(4, 6, 2);
-    d.add_edge(6, 8, 6);
-
-    SUBCASE("Test 所有路径") {
-        std::vector<std::pair<int, std::vector<std::pair<int, int>>>> except_paths = {
-            {0, {{0, 0}}},
-            {1, {{0, 0}, {1, 1}}},
-            {2, {{0, 0}, {1, 1}, {1, 2}}},
-            {3, {{0, 0}, {1, 1}, {1, 2}, {1, 3}}},
-            {8, {{0, 0}, {8, 4}}},
-            {4, {{0, 0}, {4, 5}}},
-            {10, {{0, 0}, {8, 4}, {2, 6}}},
-            {4, {{0, 0}, {1, 1}, {1, 2}, {1, 3}, {1, 7}}},
-            {5, {{0, 0}, {4, 5}, {1, 8}}},
-        };
-
-        auto short_paths = d.dijkstra(0);
-        CHECK(short_paths == except_paths);
+
+    /**
+     * @brief 并发双向搜索的一个方向，Dir 为 0 时为正向。own 只由本线程写入，other 只通过 peek 读取。
+     * 一个方向的队列为空时另一方向也随之结束：此时所有经过它的路径都已检查过。
+     */
+    template <int Dir>
+    void search_direction(Workspace &own, Workspace &other, Meeting &meet) {
+        const G &graph = Dir == 0 ? g : gr;
+        [[maybe_unused]] auto timer = own.stats.phase(Phase::Search);
+        while (!own.pq.empty() && !meet.done.load(std::memory_order_relaxed)) {
+            auto [cur_dist, cur_node] = own.pq.top();
+            own.pq.pop();
+
+            bool stale = own.dist[cur_node] < cur_dist;
+            own.stats.on_pop(stale);
+            if (stale) continue;
+            ++own.settled;
+            own.stats.on_settle();
+
+            // 先读另一方向的出队距离，再读 estimate。另一方向尚未出队时取 0：
+            // 线程没有被调度到另一方向时，本方向单独搜到对方的起点即可结束
+            T other_top = meet.top[1 - Dir].load(std::memory_order_acquire);
+            T estimate = meet.estimate.load(std::memory_order_relaxed);
+            if (other_top == infinity<T>()) other_top = 0;
+            if (saturating_add(cur_dist, other_top) >= estimate) break;
+            meet.top[Dir].store(cur_dist, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            for (const auto &[cost, next_node] : graph[cur_node]) {
+                own.stats.on_scan();
+                T cand = saturating_add(cur_dist, cost);
+                if (cand < own.get(next_node, infinity<T>())) {
+                    own.publish(next_node, cand, {cost, cur_node});
+                    own.stats.on_relax();
+                    own.pq.push(cand, next_node);
+                    own.stats.on_push();
+                }
+
+                T other_dist = other.peek(next_node, infinity<T>());
+                if (other_dist == infinity<T>()) continue;
+                T through = saturating_add(cand, other_dist);
+                bool improved = Dir == 0 ? meet.improve(through, cur_node, next_node, cost)
+                                         : meet.improve(through, next_node, cur_node, cost);
+                if (improved) own.stats.on_meet();
+            }
+        }
+        meet.done.store(true, std::memory_order_relaxed);
     }
-}
-
-TEST_CASE("DijkstraTest3") {
-    BiDirDijkstra<int> d(9);
-    d.add_edge(0, 1, 1);
-    d.add_edge(0, 5, 4);
-    d.add_edge(0, 4, 8);
-    d.add_edge(1, 2, 1);
-    d.add_edge(2, 3, 1);
-    d.add_edge(3, 7, 1);
-    d.add_edge(7, 8, 2);
-    d.add_edge(5, 8, 1);
-    d.add_edge(4, 6, 2);
-    d.add_edge(6, 8, 6);
-
-    ankerl::nanobench::Bench().run("BiDijkstra", [&] { d.shortest_dist(0, 8); });
-}
+};
 
 #endif
@@ -0,0 +1,327 @@
+#ifndef PATH_COMPRESSED_GRAPH_H
+#define PATH_COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PATH_GROUP_VARINT_SSSE3 1
+#endif
+
+#include "csr_graph.h"
+#include "weight.h"
+
+static_assert(std::endian::native == std::endian::little, "compressed graphs assume a little-endian host");
+
+/**
+ * 分组变长整数 (group varint)：每 4 个 uint32 共用一个控制字节，第 i 个值占 ((ctrl >> 2i) & 3) + 1 个字节。
+ * 解码时一次读入 16 个字节，因此编码流末尾需要 PADDING 个字节的填充。
+ */
+namespace group_varint {
+
+constexpr std::size_t PADDING = 16;
+
+inline constexpr std::array<std::uint8_t, 256> LENGTHS = [] {
+    std::array<std::uint8_t, 256> len{};
+    for (int c = 0; c < 256; ++c) len[c] = 1 + ((c & 3) + 1) + ((c >> 2 & 3) + 1) + ((c >> 4 & 3) + 1) + ((c >> 6 & 3) + 1);
+    return len;
+}();
+
+inline void encode(const std::uint32_t v[4], std::vector<std::uint8_t> &out) {
+    std::size_t head = out.size();
+    out.push_back(0);
+    std::uint8_t ctrl = 0;
+    for (int i = 0; i < 4; ++i) {
+        int bytes = v[i] < (1u << 8) ? 1 : v[i] < (1u << 16) ? 2 : v[i] < (1u << 24) ? 3 : 4;
+        ctrl |= std::uint8_t(bytes - 1) << (2 * i);
+        for (int b = 0; b < bytes; ++b) out.push_back(std::uint8_t(v[i] >> (8 * b)));
+    }
+    out[head] = ctrl;
+}
+
+/**
+ * @brief 解码从 p 开始的一组 4 个值，返回下一组的起点。
+ */
+inline const std::uint8_t *decode_scalar(const std::uint8_t *p, std::uint32_t out[4]) {
+    const std::uint8_t ctrl = *p++;
+    for (int i = 0; i < 4; ++i) {
+        int bytes = (ctrl >> (2 * i) & 3) + 1;
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        out[i] = bytes == 4 ? v : v & ((1u << (8 * bytes)) - 1);
+        p += bytes;
+    }
+    return p;
+}
+
+#ifdef PATH_GROUP_VARINT_SSSE3
+/**
+ * @brief 每个控制字节对应的 pshufb 掩码：把 4 个值的字节分散到 4 个 32 位车道，高位填 0 (0x80)。
+ */
+inline const std::array<std::array<std::uint8_t, 16>, 256> SHUFFLE = [] {
+    std::array<std::array<std::uint8_t, 16>, 256> table{};
+    for (int c = 0; c < 256; ++c) {
+        int src = 0;
+        for (int i = 0; i < 4; ++i) {
+            int bytes = (c >> (2 * i) & 3) + 1;
+            for (int b = 0; b < 4; ++b) table[c][4 * i + b] = b < bytes ? std::uint8_t(src + b) : 0x80;
+            src += bytes;
+        }
+    }
+    return table;
+}();
+
+__attribute__((target("ssse3"))) inline const std::uint8_t *decode_ssse3(const std::uint8_t *p, std::uint32_t out[4]) {
+    const std::uint8_t ctrl = *p;
+    auto data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 1));
+    auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(SHUFFLE[ctrl].data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(data, mask));
+    return p + LENGTHS[ctrl];
+}
+
+inline bool ssse3_available() {
+    static const bool ok = __builtin_cpu_supports("ssse3");
+    return ok;
+}
+#else
+inline bool ssse3_available() { return false; }
+#endif
+
+inline const std::uint8_t *decode(const std::uint8_t *p, std::uint32_t out[4], bool simd) {
+#ifdef PATH_GROUP_VARINT_SSSE3
+    if (simd) return decode_ssse3(p, out);
+#endif
+    return decode_scalar(p, out);
+}
+
+}  // namespace group_varint
+
+/**
+ * @brief 压缩的只读有向图，接口与 CSRGraph 相同：for (const auto &[c, to] : g[u]) 在遍历时逐组解码。
+ *
+ * 每个节点的编码为 [变长整数的出度][出度个 W 类型的边权][分组变长整数的目标节点]。
+ * 目标节点按编号排序后，第一个记为相对 u 的 zigzag 差值，其余记为与前一个的间隔，编号局部性越好越短；
+ * 差值和间隔都以 32 位保存，超出时 assign 抛出 std::length_error。
+ * 节点的起点由每 64 个节点一个的 64 位基址加每个节点一个的 32 位相对偏移给出。
+ *
+ * 边权以 W 类型保存为 round(c / scale)，解码为 W * scale。默认要求每条边都能无损还原，否则抛出
+ * std::invalid_argument；lossy 为 true 时允许量化，此时搜索得到的是量化后的图上的距离。
+ *
+ * @tparam T 边权类型
+ * @tparam W 保存边权的类型，如 std::uint16_t
+ * @tparam V 节点编号类型，见 NodeId
+ */
+template <typename T, typename W = T, NodeId V = std::uint32_t>
+struct CompressedGraph {
+    using node_type = V;
+    using E = std::pair<T, V>;  // 权重, 节点
+    static constexpr int BLOCK = 64;
+
+    V n = 0;
+    T scale = T(1);      // 边权的量化步长
+    bool lossy = false;  // 是否允许量化误差
+    bool use_simd = group_varint::ssse3_available();
+    std::vector<std::uint64_t> base;      // 每 BLOCK 个节点的起点
+    std::vector<std::uint32_t> relative;  // 节点起点相对所在块起点的偏移
+    std::vector<std::uint8_t> bytes;      // 编码流，末尾有 PADDING 个字节的填充
+    std::size_t edges = 0;
+
+    CompressedGraph() = default;
+    CompressedGraph(V N) : n(N) { assign(CSRGraph<T, V>(N)); }
+    explicit CompressedGraph(const CSRGraph<T, V> &g, T step = T(1), bool allow_lossy = false)
+        : scale(step), lossy(allow_lossy) {
+        assign(g);
+    }
+
+    struct Range {
+        const std::uint8_t *p;  // 第一组目标节点
+        const std::uint8_t *w;  // 第一个边权
+        std::size_t len;
+        V u;
+        T scale;
+        bool simd;
+
+        struct iterator {
+            const std::uint8_t *p = nullptr, *w = nullptr;
+            std::size_t left = 0;
+            T scale = T(1);
+            bool simd = false;
+            int k = 0;
+            V cur = 0;
+            std::uint32_t buf[4] = {};
+
+            E operator*() const {
+                W x;
+                std::memcpy(&x, w, sizeof(W));
+                return {static_cast<T>(x) * scale, cur};
+            }
+            iterator &operator++() {
+                w += sizeof(W);
+                if (--left == 0) return *this;
+                if (++k == 4) p = group_varint::decode(p, buf, simd), k = 0;
+                cur += static_cast<V>(buf[k]);
+                return *this;
+            }
+            bool operator!=(const iterator &o) const { return left != o.left; }
+            bool operator==(const iterator &o) const { return left == o.left; }
+        };
+
+        iterator begin() const {
+            iterator it{p, w, len, scale, simd, 0, 0, {}};
+            if (len == 0) return it;
+            it.p = group_varint::decode(p, it.buf, simd);
+            std::uint32_t z = it.buf[0];
+            it.cur = u + static_cast<V>(static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1));
+            return it;
+        }
+        iterator end() const { return {p, w, 0, scale, simd, 0, 0, {}}; }
+        std::size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+    };
+
+    std::size_t edge_count() const { return edges; }
+    std::size_t degree(V u) const { return (*this)[u].size(); }
+
+    /**
+     * @brief 编码后占用的字节数 (不含 vector 的额外容量)。
+     */
+    std::size_t memory_bytes() const {
+        return base.size() * sizeof(std::uint64_t) + relative.size() * sizeof(std::uint32_t) + bytes.size();
+    }
+
+    Range operator[](V u) const {
+        const std::uint8_t *p = bytes.data() + base[u / BLOCK] + relative[u];
+        std::size_t len = 0;
+        for (int shift = 0;; shift += 7) {  // 变长整数的出度
+            std::uint8_t b = *p++;
+            len |= std::size_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) break;
+        }
+        return {p + len * sizeof(W), p, len, u, scale, use_simd};
+    }
+
+    /**
+     * @brief 把 g 按当前的 scale / lossy 重新编码。
+     */
+    void assign(const CSRGraph<T, V> &g) {
+        n = g.n;
+        edges = g.edge_count();
+        base.assign((std::size_t(n) + BLOCK - 1) / BLOCK + 1, 0);
+        relative.assign(n, 0);
+        bytes.clear();
+
+        std::vector<E> adj;
+        std::vector<std::uint32_t> values;
+        for (V u = 0; u < n; ++u) {
+            if (u % BLOCK == 0) base[u / BLOCK] = bytes.size();
+            std::size_t offset = bytes.size() - base[u / BLOCK];
+            if (offset > std::numeric_limits<std::uint32_t>::max())
+                throw std::length_error("compressed graph block exceeds 4 GiB");
+            relative[u] = static_cast<std::uint32_t>(offset);
+
+            adj.clear();
+            for (const auto &[c, to] : g[u]) adj.emplace_back(c, to);
+            std::sort(adj.begin(), adj.end(), [](const E &a, const E &b) { return a.second < b.second; });
+
+            std::size_t len = adj.size();
+            do {
+                bytes.push_back(std::uint8_t((len & 0x7f) | (len > 0x7f ? 0x80 : 0)));
+                len >>= 7;
+            } while (len);
+
+            for (const auto &[c, to] : adj) {
+                W x = quantize(c);
+                auto *raw = reinterpret_cast<const std::uint8_t *>(&x);
+                bytes.insert(bytes.end(), raw, raw + sizeof(W));
+            }
+
+            values.clear();
+            for (std::size_t i = 0; i < adj.size(); ++i) {
+                std::uint64_t x;
+                if (i == 0) {
+                    std::int64_t d = static_cast<std::make_signed_t<V>>(adj[0].second - u);  // 解码时按模 2^k 相加
+                    x = static_cast<std::uint64_t>((d << 1) ^ (d >> 63));  // zigzag
+                } else {
+                    x = adj[i].second - adj[i - 1].second;
+                }
+                if (x > std::numeric_limits<std::uint32_t>::max())
+                    throw std::length_error("compressed graph node gap exceeds 32 bits");
+                values.push_back(static_cast<std::uint32_t>(x));
+            }
+            values.resize((values.size() + 3) / 4 * 4, 0);
+            for (std::size_t i = 0; i < values.size(); i += 4) group_varint::encode(values.data() + i, bytes);
+        }
+        bytes.resize(bytes.size() + group_varint::PADDING, 0);
+        bytes.shrink_to_fit();
+    }
+
+    /**
+     * @brief 边权 c 的存储值，不能无损保存且不允许量化时抛出 std::invalid_argument。
+     */
+    W quantize(T c) const {
+        long double q = static_cast<long double>(c) / static_cast<long double>(scale);
+        if constexpr (std::is_integral_v<W>) {
+            q = std::round(q);
+            if (q < static_cast<long double>(std::numeric_limits<W>::min()) ||
+                q > static_cast<long double>(std::numeric_limits<W>::max()))
+                throw std::invalid_argument("edge weight does not fit the compressed weight type");
+        }
+        W x = static_cast<W>(q);
+        if (!lossy && static_cast<T>(x) * scale != c)
+            throw std::invalid_argument("edge weight cannot be stored exactly; allow lossy quantization");
+        return x;
+    }
+
+    /**
+     * @brief 解码为 CSR 图，用于合并新加入的边或建立可达性索引。
+     */
+    CSRGraph<T, V> to_csr() const {
+        CSRGraph<T, V> g(n);
+        for (V u = 0; u < n; ++u) g.offsets[u + 1] = g.offsets[u] + degree(u);
+        g.targets.resize(edges);
+        g.weights.resize(edges);
+        std::size_t i = 0;
+        for (V u = 0; u < n; ++u)
+            for (const auto &[c, to] : (*this)[u]) g.targets[i] = to, g.weights[i++] = c;
+        return g;
+    }
+};
+
+/**
+ * @brief 引擎在不同图表示之间共用的操作：CSRGraph 原样使用，压缩图先解码。
+ */
+template <typename T, NodeId V>
+const CSRGraph<T, V> &to_csr(const CSRGraph<T, V> &g) {
+    return g;
+}
+
+template <typename T, typename W, NodeId V>
+CSRGraph<T, V> to_csr(const CompressedGraph<T, W, V> &g) {
+    return g.to_csr();
+}
+
+/**
+ * @brief 把缓冲的边合并进图：CSRGraph 直接重建，压缩图解码、合并后按原来的编码参数重新编码。
+ */
+template <typename T, NodeId V>
+void merge_pending(CSRGraph<T, V> &g, const CSRBuilder<T, V> &pending, bool reverse = false) {
+    g = pending.build(&g, reverse);
+}
+
+template <typename T, typename W, NodeId V>
+void merge_pending(CompressedGraph<T, W, V> &g, const CSRBuilder<T, V> &pending, bool reverse = false) {
+    auto base = g.to_csr();
+    g.assign(pending.build(&base, reverse));
+}
+
+#endif
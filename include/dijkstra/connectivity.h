@@ -0,0 +1,212 @@
+#ifndef PATH_CONNECTIVITY_H
+#define PATH_CONNECTIVITY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "weight.h"
+
+/**
+ * @brief 可达性索引：强连通分量 + 缩点 DAG 上的区间标号，用于在搜索前排除不可达的查询。
+ *
+ * 分量由迭代的 Tarjan 算法求出，按逆拓扑序编号，缩点 DAG 的边只从编号大的分量指向编号小的分量。
+ * 每个分量另有 LABELS 组 DFS 后序区间 [low, post] (GRAIL)：a 能到达 b 时，每一组中 b 的区间都包含于 a 的区间。
+ * 查询依次检查：同一分量 (可达)、拓扑序、区间包含，这些都是 O(1) 的；都无法判定时在缩点 DAG 上
+ * 做一次用区间剪枝的 DFS，结果总是精确的。
+ *
+ * @tparam V 节点编号类型，见 NodeId；分量编号和区间标号也用 V 表示
+ */
+template <NodeId V = std::uint32_t>
+struct ConnectivityIndex {
+    static constexpr int LABELS = 2;
+    static constexpr V NONE = no_node<V>();  // 尚未编号
+    struct Interval {
+        V low, post;
+    };
+
+    std::vector<V> component;          // 节点 -> 强连通分量编号
+    std::vector<std::size_t> offsets;  // 缩点 DAG 的 CSR 邻接表，边已去重
+    std::vector<V> targets;
+    std::vector<Interval> labels[LABELS];
+
+    ConnectivityIndex() = default;
+
+    template <typename T>
+    explicit ConnectivityIndex(const CSRGraph<T, V> &g) {
+        strong_components(g);
+        condense(g);
+        for (int k = 0; k < LABELS; ++k) label(k);
+    }
+
+    bool empty() const { return component.empty(); }
+    V size() const { return static_cast<V>(component.size()); }
+    V component_count() const { return static_cast<V>(offsets.size() - 1); }
+
+    /**
+     * @brief s 能否到达 t，s 或 t 越界时返回 false。
+     */
+    bool reachable(V s, V t) const {
+        if (s >= size() || t >= size()) return false;
+        V cs = component[s], ct = component[t];
+        if (cs == ct) return true;
+        if (!may_reach(cs, ct)) return false;
+
+        // 区间无法排除时在缩点 DAG 上搜索，visited 按 generation 惰性重置
+        thread_local std::vector<std::uint32_t> visited;
+        thread_local std::uint32_t generation = 0;
+        thread_local std::vector<V> stack;
+        if (visited.size() < offsets.size()) visited.resize(offsets.size(), 0);
+        if (++generation == 0) std::fill(visited.begin(), visited.end(), 0), generation = 1;
+
+        stack.assign(1, cs);
+        visited[cs] = generation;
+        while (!stack.empty()) {
+            V c = stack.back();
+            stack.pop_back();
+            for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+                V d = targets[i];
+                if (d == ct) return true;
+                if (visited[d] == generation || !may_reach(d, ct)) continue;
+                visited[d] = generation;
+                stack.push_back(d);
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 分量 a 是否可能到达分量 b：为 false 时一定不可达。
+     */
+    bool may_reach(V a, V b) const {
+        if (a < b) return false;  // 逆拓扑序
+        for (int k = 0; k < LABELS; ++k)
+            if (labels[k][b].low < labels[k][a].low || labels[k][a].post < labels[k][b].post) return false;
+        return true;
+    }
+
+    /**
+     * @brief 迭代的 Tarjan 算法，用显式栈代替递归，不受调用栈深度限制。
+     */
+    template <typename T>
+    void strong_components(const CSRGraph<T, V> &g) {
+        const V n = g.n;
+        component.assign(n, NONE);
+        std::vector<V> index(n, NONE), low(n);
+        std::vector<V> stack;                          // Tarjan 栈
+        std::vector<std::pair<V, std::size_t>> calls;  // 节点, 下一条要检查的边
+        V counter = 0, count = 0;
+
+        for (V root = 0; root < n; ++root) {
+            if (index[root] != NONE) continue;
+            index[root] = low[root] = counter++;
+            stack.push_back(root);
+            calls.emplace_back(root, g.offsets[root]);
+            while (!calls.empty()) {
+                V v = calls.back().first;
+                std::size_t &i = calls.back().second;
+                if (i < g.offsets[v + 1]) {
+                    V w = g.targets[i++];
+                    if (index[w] == NONE) {
+                        index[w] = low[w] = counter++;
+                        stack.push_back(w);
+                        calls.emplace_back(w, g.offsets[w]);
+                    } else if (component[w] == NONE) {  // w 仍在 Tarjan 栈中
+                        low[v] = std::min(low[v], index[w]);
+                    }
+                    continue;
+                }
+                calls.pop_back();
+                if (!calls.empty()) low[calls.back().first] = std::min(low[calls.back().first], low[v]);
+                if (low[v] != index[v]) continue;
+                V w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    component[w] = count;
+                } while (w != v);
+                ++count;
+            }
+        }
+        offsets.assign(std::size_t(count) + 1, 0);
+    }
+
+    /**
+     * @brief 由分量编号构造去重后的缩点 DAG。
+     */
+    template <typename T>
+    void condense(const CSRGraph<T, V> &g) {
+        const V count = component_count();
+        for (V u = 0; u < g.n; ++u)
+            for (std::size_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+                if (component[g.targets[i]] != component[u]) ++offsets[component[u] + 1];
+        for (V c = 0; c < count; ++c) offsets[c + 1] += offsets[c];
+        targets.resize(offsets[count]);
+        std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+        for (V u = 0; u < g.n; ++u)
+            for (std::size_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+                if (V c = component[g.targets[i]]; c != component[u]) targets[pos[component[u]]++] = c;
+
+        std::size_t out = 0, first = 0;  // 每个分量的出边排序去重后原地压缩
+        for (V c = 0; c < count; ++c) {
+            std::size_t last = offsets[c + 1];
+            std::sort(targets.begin() + first, targets.begin() + last);
+            auto end = std::unique(targets.begin() + first, targets.begin() + last);
+            offsets[c] = out;
+            out = std::copy(targets.begin() + first, end, targets.begin() + out) - targets.begin();
+            first = last;
+        }
+        offsets[count] = out;
+        targets.resize(out);
+    }
+
+    /**
+     * @brief 第 k 组区间标号：迭代 DFS 的后序编号 post 和子孙 (包括非树边可达的) 中最小的 post。
+     * 奇数组按相反的顺序访问根和出边，使两组标号尽量不同。
+     */
+    void label(int k) {
+        const V count = component_count();
+        auto &lab = labels[k];
+        lab.assign(count, {NONE, 0});
+        std::vector<std::pair<V, std::size_t>> calls;  // 分量, 已检查的出边数
+        V counter = 0;
+        auto child = [&](V c, std::size_t j) {
+            return k % 2 == 0 ? targets[offsets[c] + j] : targets[offsets[c + 1] - 1 - j];
+        };
+
+        for (V r = 0; r < count; ++r) {
+            V root = k % 2 == 0 ? count - 1 - r : r;  // 偶数组从拓扑序靠前的分量开始
+            if (lab[root].low != NONE) continue;
+            lab[root].low = NONE - 1;  // 标记为已进入
+            calls.emplace_back(root, 0);
+            while (!calls.empty()) {
+                auto &[c, j] = calls.back();
+                if (j < offsets[c + 1] - offsets[c]) {
+                    V d = child(c, j++);
+                    if (lab[d].low == NONE) {
+                        lab[d].low = NONE - 1;
+                        calls.emplace_back(d, 0);  // c, j 引用在此之后失效
+                    } else {                       // DAG 中已进入的后继一定已经完成
+                        lab[c].low = std::min(lab[c].low, lab[d].low);
+                    }
+                    continue;
+                }
+                V done = c;
+                lab[done].post = counter++;
+                lab[done].low = std::min(lab[done].low, lab[done].post);
+                calls.pop_back();
+                if (!calls.empty()) {
+                    V parent = calls.back().first;
+                    lab[parent].low = std::min(lab[parent].low, lab[done].low);
+                }
+            }
+        }
+    }
+};
+
+template <typename T, NodeId V>
+ConnectivityIndex(const CSRGraph<T, V> &) -> ConnectivityIndex<V>;
+
+#endif
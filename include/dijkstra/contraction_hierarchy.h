@@ -0,0 +1,411 @@
+#ifndef PATH_CONTRACTION_HIERARCHY_H
+#define PATH_CONTRACTION_HIERARCHY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "bidirectional_dijkstra.h"
+#include "csr_graph.h"
+#include "dijkstra.h"
+#include "priority_queue.h"
+#include "weight.h"
+#include "workspace.h"
+
+/**
+ * @brief 收缩层次 (Contraction Hierarchies)。
+ *
+ * 预处理按重要性 (edge difference + 已收缩邻居数) 依次收缩节点，收缩 v 时对每对邻居 u -> v -> w
+ * 做受限的 witness 搜索，找不到更短的替代路径时添加捷径 u -> w。
+ * 查询只沿 rank 递增的边做双向搜索，并使用 stall-on-demand 剪枝，最后把捷径展开为原图中的边。
+ *
+ * witness 搜索同时受跳数和每次收缩的确定节点总数限制，找不到 witness 时多加捷径，不影响正确性。
+ * 未收缩邻居数超过 core_degree_limit 的节点不再收缩，留作核心 (幂律图的枢纽节点)：核心节点排在最后，
+ * 彼此之间的边同时放入 up 和 down，查询到达核心后在核心内做普通的双向 Dijkstra，预处理时间因此有界。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ * @tparam Q 优先队列策略，见 priority_queue.h
+ */
+template <Weight T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>>
+struct ContractionHierarchy {
+    using E = std::pair<T, V>;
+    using M = std::pair<T, std::vector<E>>;
+    using Workspace = SearchWorkspace<T, Q>;
+    static constexpr T INF = infinity<T>();
+    static constexpr V NONE = no_node<V>();
+
+    V n;
+    CSRGraph<T, V> g;          // 原图
+    CSRBuilder<T, V> pending;  // 尚未预处理的边
+
+    std::vector<V> rank;               // 收缩顺序，越大越重要
+    CSRGraph<T, V> up, down;           // up[u]: u -> x 且 rank[x] > rank[u]；down[u]: x -> u 且 rank[x] > rank[u]
+                                       // (两端都是核心节点的边不受 rank 限制)
+    std::vector<V> up_mid;             // 与 up 的边一一对应，捷径的中间节点，原始边为 NONE
+    std::vector<V> down_mid;           // 与 down 的边一一对应
+    int witness_settle_limit = 500;    // 每次 witness 搜索最多确定的节点数，越小预处理越快但捷径越多
+    int witness_hop_limit = 5;         // witness 路径最多包含的边数
+    int witness_settle_budget = 5000;  // 收缩一个节点时所有 witness 搜索确定的节点总数，用完后剩余的邻居对直接加捷径
+    int core_degree_limit = 64;        // 未收缩的入边 + 出边数超过该值的节点留在核心中不再收缩
+    V core = 0;                        // 核心节点数
+
+    ContractionHierarchy(V N) : n(N), g(N), pending(N), up(N), down(N) {}
+
+    bool check(V u) { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return;
+        pending.add(u, v, cost);
+    }
+
+    std::size_t shortcut_count() const {
+        return std::count_if(up_mid.begin(), up_mid.end(), [](V m) { return m != NONE; }) +
+               std::count_if(down_mid.begin(), down_mid.end(), [](V m) { return m != NONE; });
+    }
+
+    /**
+     * @brief 收缩所有节点并生成上行/下行 CSR 图。查询前会自动调用；之后再 add_edge 会触发重新预处理。
+     */
+    void preprocess() {
+        if (pending.empty() && !rank.empty()) return;
+        g = pending.build(&g);
+        pending.clear();
+
+        Contractor c(*this);
+        c.run();
+    }
+
+    /**
+     * @brief 求 s 到 t 的最短路径，返回值与 BiDirDijkstra::shortest_path 相同：路径中的捷径已展开为原图的边。
+     */
+    M shortest_path(V s, V t, Workspace &fw, Workspace &bw) {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        preprocess();
+
+        auto [dist, meet] = search(s, t, fw, bw);
+        if (meet == NONE) return {INF, {}};  // 未找到路径
+
+        // 上行图中的节点序列 s ... meet ... t
+        std::vector<V> nodes;
+        for (V cur = meet; cur != NONE; cur = fw.prev[cur].second) nodes.push_back(cur);
+        std::reverse(nodes.begin(), nodes.end());
+        for (V cur = bw.prev[meet].second; cur != NONE; cur = bw.prev[cur].second) nodes.push_back(cur);
+
+        std::vector<E> path{{0, s}};
+        for (std::size_t i = 0; i + 1 < nodes.size(); ++i) unpack(nodes[i], nodes[i + 1], path);
+        return {dist, path};
+    }
+
+    M shortest_path(V s, V t) {
+        return shortest_path(s, t, thread_workspace<T, Q, 0>(), thread_workspace<T, Q, 1>());
+    }
+
+    T shortest_dist(V s, V t, Workspace &fw, Workspace &bw) {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        preprocess();
+        return search(s, t, fw, bw).first;
+    }
+
+    T shortest_dist(V s, V t) { return shortest_dist(s, t, thread_workspace<T, Q, 0>(), thread_workspace<T, Q, 1>()); }
+
+    /**
+     * @brief 上行双向搜索。
+     *
+     * @return (最短距离, 相遇节点)，不可达时相遇节点为 NONE、距离为 INF
+     */
+    std::pair<T, V> search(V s, V t, Workspace &fw, Workspace &bw) {
+        Workspace *ws[2] = {&fw, &bw};
+        const CSRGraph<T, V> *graph[2] = {&up, &down};  // 正向沿 up 扩展，反向沿 down 扩展
+        const CSRGraph<T, V> *stall[2] = {&down, &up};  // 用于 stall-on-demand 的反方向边
+
+        fw.reset(n), bw.reset(n);
+        fw.set(s, 0, {0, NONE}), bw.set(t, 0, {0, NONE});
+        fw.pq.push(0, s);
+        bw.pq.push(0, t);
+
+        T best = INF;  // 尚未相遇
+        V meet = NONE;
+        bool progressed = true;
+        while (progressed) {
+            progressed = false;
+            for (int dir = 0; dir < 2; ++dir) {
+                auto &self = *ws[dir];
+                auto &other = *ws[dir ^ 1];
+                if (self.pq.empty()) continue;
+
+                auto [d, u] = self.pq.top();
+                if (d >= best) {  // 该方向不可能再找到更短的路径
+                    self.pq.clear();
+                    continue;
+                }
+                self.pq.pop();
+                progressed = true;
+                if (self.dist[u] < d) continue;
+                ++self.settled;
+
+                if (other.reached(u) && saturating_add(d, other.dist[u]) < best) {
+                    best = saturating_add(d, other.dist[u]);
+                    meet = u;
+                }
+
+                // stall-on-demand：若存在从更高 rank 节点过来的更短路径，u 的距离不是最短的，无需扩展
+                bool stalled = false;
+                for (const auto &[c, x] : (*stall[dir])[u]) {
+                    if (self.reached(x) && saturating_add(self.dist[x], c) < d) {
+                        stalled = true;
+                        break;
+                    }
+                }
+                if (stalled) continue;
+
+                for (const auto &[c, x] : (*graph[dir])[u]) {
+                    T cand = saturating_add(d, c);
+                    if (cand < self.get(x, infinity<T>())) {
+                        self.set(x, cand, {c, u});
+                        self.pq.push(cand, x);
+                    }
+                }
+            }
+        }
+        return {best, meet};
+    }
+
+    /**
+     * @brief 查找层次图中的边 a -> b，返回 (权重, 中间节点)。
+     */
+    std::pair<T, V> find_edge(V a, V b) const {
+        if (rank[a] < rank[b]) {
+            for (auto i = up.offsets[a]; i < up.offsets[a + 1]; ++i)
+                if (up.targets[i] == b) return {up.weights[i], up_mid[i]};
+        } else {
+            for (auto i = down.offsets[b]; i < down.offsets[b + 1]; ++i)
+                if (down.targets[i] == a) return {down.weights[i], down_mid[i]};
+        }
+        return {INF, NONE};
+    }
+
+    /**
+     * @brief 将层次图中的边 a -> b 展开为原图的边，依次追加 (权重, 节点) 到 path。
+     */
+    void unpack(V a, V b, std::vector<E> &path) const {
+        std::vector<std::pair<V, V>> stack{{a, b}};
+        while (!stack.empty()) {
+            auto [x, y] = stack.back();
+            stack.pop_back();
+            auto [c, mid] = find_edge(x, y);
+            if (mid == NONE) {
+                path.emplace_back(c, y);
+            } else {
+                stack.emplace_back(mid, y);  // 后处理的后半段先入栈
+                stack.emplace_back(x, mid);
+            }
+        }
+    }
+
+    /**
+     * @brief 预处理期间使用的动态图，收缩结束后释放。
+     */
+    struct Contractor {
+        struct Arc {
+            V to;
+            T cost;
+            V mid;
+        };
+
+        ContractionHierarchy &ch;
+        V n;
+        std::vector<std::vector<Arc>> out, in;
+        std::vector<char> contracted;
+        std::vector<int> deleted;  // 已收缩的邻居数
+        std::vector<std::vector<Arc>> up_arcs, down_arcs;
+        std::vector<int> hops;  // witness 搜索中到达各节点的边数，ws.reached 时有效
+        Workspace ws;
+
+        static constexpr int CORE = std::numeric_limits<int>::max();  // 核心节点的优先级
+
+        Contractor(ContractionHierarchy &c)
+            : ch(c), n(c.n), out(c.n), in(c.n), contracted(c.n, 0), deleted(c.n, 0), up_arcs(c.n), down_arcs(c.n),
+              hops(c.n, 0) {}
+
+        /**
+         * @brief 添加边 u -> w，已有更短或相同的边时忽略，已有更长的边时替换。
+         */
+        void add_arc(V u, V w, T cost, V mid) {
+            for (auto &a : out[u]) {
+                if (a.to != w) continue;
+                if (!(cost < a.cost)) return;
+                a.cost = cost, a.mid = mid;
+                for (auto &b : in[w])
+                    if (b.to == u) b.cost = cost, b.mid = mid;
+                return;
+            }
+            out[u].push_back({w, cost, mid});
+            in[w].push_back({u, cost, mid});
+        }
+
+        /**
+         * @brief 在未收缩的节点上从 u 出发做受限 Dijkstra，跳过正在收缩的节点 v。
+         *
+         * @param budget 最多确定的节点数，返回实际确定的节点数
+         */
+        int witness_search(V u, V v, T bound, int budget) {
+            ws.reset(n);
+            ws.set(u, 0);
+            hops[u] = 0;
+            ws.pq.push(0, u);
+            int settled = 0, limit = std::min(budget, ch.witness_settle_limit);
+            while (!ws.pq.empty()) {
+                auto [d, x] = ws.pq.top();
+                ws.pq.pop();
+                if (ws.dist[x] < d) continue;
+                if (bound < d || settled >= limit) break;
+                ++settled;
+                if (hops[x] >= ch.witness_hop_limit) continue;
+                for (const auto &a : out[x]) {
+                    if (contracted[a.to] || a.to == v) continue;
+                    T cand = saturating_add(d, a.cost);
+                    if (cand < ws.get(a.to, infinity<T>())) {
+                        ws.set(a.to, cand);
+                        hops[a.to] = hops[x] + 1;
+                        ws.pq.push(cand, a.to);
+                    }
+                }
+            }
+            return settled;
+        }
+
+        /**
+         * @brief 收缩节点 v，simulate 为 true 时只统计需要的捷径数。
+         */
+        int contract(V v, bool simulate) {
+            int shortcuts = 0, budget = ch.witness_settle_budget;
+            for (const auto &[u, c1, m1] : in[v]) {
+                if (contracted[u] || u == v) continue;
+                bool any = false;
+                T bound = 0;
+                for (const auto &[w, c2, m2] : out[v]) {
+                    if (contracted[w] || w == u || w == v) continue;
+                    bound = any ? std::max(bound, saturating_add(c1, c2)) : saturating_add(c1, c2);
+                    any = true;
+                }
+                if (!any) continue;
+
+                if (budget > 0) {
+                    budget -= witness_search(u, v, bound, budget);
+                } else {
+                    ws.reset(n);  // 预算用完，不再找 witness
+                }
+                for (const auto &[w, c2, m2] : out[v]) {
+                    if (contracted[w] || w == u || w == v) continue;
+                    T cost = saturating_add(c1, c2);
+                    if (cost == infinity<T>()) continue;                  // 超出类型范围的路径视为不可达
+                    if (ws.reached(w) && !(cost < ws.dist[w])) continue;  // 找到 witness
+                    ++shortcuts;
+                    if (!simulate) add_arc(u, w, cost, v);
+                }
+            }
+            return shortcuts;
+        }
+
+        int degree(const std::vector<Arc> &arcs) const {
+            return std::count_if(arcs.begin(), arcs.end(), [&](const Arc &a) { return !contracted[a.to]; });
+        }
+
+        int priority(V v) {
+            int in_degree = degree(in[v]), out_degree = degree(out[v]);
+            if (in_degree + out_degree > ch.core_degree_limit) return CORE;  // 不模拟收缩，避免平方级的邻居对
+            return contract(v, true) - in_degree - out_degree + deleted[v];
+        }
+
+        void run() {
+            for (V u = 0; u < n; ++u)
+                for (const auto &[c, to] : ch.g[u])
+                    if (u != to) add_arc(u, to, c, NONE);
+
+            using P = std::pair<int, V>;  // 优先级, 节点
+            std::priority_queue<P, std::vector<P>, std::greater<P>> order;
+            for (V v = 0; v < n; ++v) order.emplace(priority(v), v);
+
+            ch.rank.assign(n, 0);
+            V next_rank = 0;
+            while (!order.empty()) {
+                auto [p, v] = order.top();
+                order.pop();
+                if (contracted[v]) continue;
+                int np = priority(v);  // 惰性更新：优先级变大且不再是最小时重新入队
+                if (!order.empty() && np > order.top().first) {
+                    order.emplace(np, v);
+                    continue;
+                }
+                if (np == CORE) break;  // 剩下的节点都是核心
+
+                for (const auto &a : out[v])
+                    if (!contracted[a.to]) up_arcs[v].push_back(a);
+                for (const auto &a : in[v])
+                    if (!contracted[a.to]) down_arcs[v].push_back(a);
+
+                contract(v, false);
+                contracted[v] = 1;
+                ch.rank[v] = next_rank++;
+
+                // 从邻居的邻接表中删除 v，之后的搜索和度数统计不再扫描已收缩的节点
+                auto erase = [&](std::vector<Arc> &arcs) {
+                    std::erase_if(arcs, [&](const Arc &x) { return x.to == v; });
+                };
+                // 邻居的优先级只在出队时重新计算 (惰性更新)，每次收缩不再模拟所有邻居
+                std::vector<V> touched;
+                for (const auto &a : up_arcs[v]) erase(in[a.to]), touched.push_back(a.to);
+                for (const auto &a : down_arcs[v]) erase(out[a.to]), touched.push_back(a.to);
+                std::vector<Arc>().swap(out[v]);
+                std::vector<Arc>().swap(in[v]);
+                std::sort(touched.begin(), touched.end());
+                touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+                for (V w : touched) ++deleted[w];
+            }
+
+            // 核心节点之间的边同时是上行边和下行边，查询在核心内不受 rank 限制；
+            // 核心内按度数排 rank，度数大的枢纽排在最后 (HubLabels 按 rank 构建标签)
+            std::vector<V> core;
+            for (V v = 0; v < n; ++v)
+                if (!contracted[v]) core.push_back(v);
+            std::stable_sort(core.begin(), core.end(),
+                             [&](V a, V b) { return out[a].size() + in[a].size() < out[b].size() + in[b].size(); });
+            ch.core = static_cast<V>(core.size());
+            for (V v : core) {
+                for (const auto &a : out[v])
+                    if (!contracted[a.to]) up_arcs[v].push_back(a);
+                for (const auto &a : in[v])
+                    if (!contracted[a.to]) down_arcs[v].push_back(a);
+                ch.rank[v] = next_rank++;
+            }
+
+            build(up_arcs, ch.up, ch.up_mid);
+            build(down_arcs, ch.down, ch.down_mid);
+        }
+
+        void build(const std::vector<std::vector<Arc>> &arcs, CSRGraph<T, V> &graph, std::vector<V> &mid) {
+            graph = CSRGraph<T, V>(n);
+            for (V u = 0; u < n; ++u) graph.offsets[u + 1] = graph.offsets[u] + arcs[u].size();
+            graph.targets.resize(graph.offsets[n]);
+            graph.weights.resize(graph.offsets[n]);
+            mid.resize(graph.offsets[n]);
+            for (V u = 0; u < n; ++u) {
+                auto i = graph.offsets[u];
+                for (const auto &a : arcs[u]) {
+                    graph.targets[i] = a.to;
+                    graph.weights[i] = a.cost;
+                    mid[i++] = a.mid;
+                }
+            }
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef PATH_CSR_GRAPH_H
+#define PATH_CSR_GRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "weight.h"
+
+/**
+ * @brief CSR 图使用的只读为主的数组：要么自己持有 std::vector，要么借用外部内存 (如 mmap 的文件)。
+ *
+ * 借用时由 keep 保持外部内存存活，拷贝只复制指针。ptr 总是指向当前数据，因此读取没有额外分支；
+ * 通过非 const 的 operator[] 或 resize 修改借用的数组时，会先复制一份到自己的 vector 中。
+ */
+template <typename X>
+struct CSRArray {
+    std::vector<X> owned;
+    std::shared_ptr<const void> keep;  // 非空表示借用外部内存
+    const X *ptr = nullptr;
+    std::size_t len = 0;
+
+    CSRArray() = default;
+    CSRArray(std::size_t n, const X &v = X()) : owned(n, v) { sync(); }
+    CSRArray(const CSRArray &o) : owned(o.owned), keep(o.keep), len(o.len) { ptr = keep ? o.ptr : owned.data(); }
+    CSRArray(CSRArray &&o) noexcept : owned(std::move(o.owned)), keep(std::move(o.keep)), ptr(o.ptr), len(o.len) {
+        o.ptr = nullptr, o.len = 0;
+    }
+    CSRArray &operator=(CSRArray o) noexcept {
+        owned.swap(o.owned), keep.swap(o.keep);
+        std::swap(ptr, o.ptr), std::swap(len, o.len);
+        return *this;
+    }
+
+    /**
+     * @brief 借用 [data, data + n)，keep 负责在所有借用者销毁前保持这段内存有效。
+     */
+    static CSRArray borrow(const X *data, std::size_t n, std::shared_ptr<const void> keep) {
+        CSRArray a;
+        a.keep = std::move(keep), a.ptr = data, a.len = n;
+        return a;
+    }
+
+    bool borrowed() const { return keep != nullptr; }
+    std::size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const X *data() const { return ptr; }
+    const X *begin() const { return ptr; }
+    const X *end() const { return ptr + len; }
+    const X &operator[](std::size_t i) const { return ptr[i]; }
+
+    X &operator[](std::size_t i) {
+        detach();
+        return owned[i];
+    }
+
+    void resize(std::size_t n) {
+        detach();
+        owned.resize(n);
+        sync();
+    }
+
+    void detach() {
+        if (!keep) return;
+        owned.assign(ptr, ptr + len);
+        keep.reset();
+        sync();
+    }
+
+    void sync() { ptr = owned.data(), len = owned.size(); }
+
+    friend bool operator==(const CSRArray &a, const std::vector<X> &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+
+/**
+ * @brief 压缩稀疏行 (CSR) 格式的有权有向图。
+ *
+ * 节点 u 的出边保存在 [offsets[u], offsets[u + 1]) 区间内，目标节点和权重分别存放在
+ * targets 与 weights 两个连续数组中，避免每个节点一次堆分配，也减少搜索时的指针跳转。
+ * 三个数组可以借用 mmap 的文件内容 (见 graph_file.h)，此时拷贝图只复制指针。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ */
+template <typename T, NodeId V = std::uint32_t>
+struct CSRGraph {
+    using node_type = V;
+    using E = std::pair<T, V>;  // 权重, 节点
+
+    /**
+     * @brief 节点 u 的出边区间，解引用得到 (权重, 节点)，
+     * 因此可以直接写成 for (const auto &[c, to] : g[u])。
+     */
+    struct Range {
+        const V *to;
+        const T *cost;
+        std::size_t len;
+
+        struct iterator {
+            const V *to;
+            const T *cost;
+            E operator*() const { return {*cost, *to}; }
+            iterator &operator++() {
+                ++to, ++cost;
+                return *this;
+            }
+            bool operator!=(const iterator &o) const { return to != o.to; }
+            bool operator==(const iterator &o) const { return to == o.to; }
+        };
+
+        iterator begin() const { return {to, cost}; }
+        iterator end() const { return {to + len, cost + len}; }
+        std::size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+    };
+
+    V n = 0;                        // 节点数
+    CSRArray<std::size_t> offsets;  // 长度为 n + 1 的行偏移
+    CSRArray<V> targets;            // 边的目标节点
+    CSRArray<T> weights;            // 边的权重
+
+    CSRGraph() = default;
+    CSRGraph(V N) : n(N), offsets(std::size_t(N) + 1, 0) {}
+
+    std::size_t edge_count() const { return targets.size(); }
+    std::size_t degree(V u) const { return offsets[u + 1] - offsets[u]; }
+
+    Range operator[](V u) const {
+        auto b = offsets[u];
+        return {targets.data() + b, weights.data() + b, offsets[u + 1] - b};
+    }
+};
+
+/**
+ * @brief CSR 图的构建器，add_edge 时只追加到三个扁平数组中，finalize 时用计数排序一次性生成 CSR。
+ */
+template <typename T, NodeId V = std::uint32_t>
+struct CSRBuilder {
+    V n;
+    std::vector<V> src, dst;
+    std::vector<T> cost;
+
+    CSRBuilder(V N = 0) : n(N) {}
+
+    bool empty() const { return src.empty(); }
+    std::size_t size() const { return src.size(); }
+
+    void add(V u, V v, T c) {
+        src.push_back(u);
+        dst.push_back(v);
+        cost.push_back(c);
+    }
+
+    void clear() {
+        src = {};
+        dst = {};
+        cost = {};
+    }
+
+    /**
+     * @brief 将缓冲的边与已有的 CSR 图合并成新的 CSR 图。
+     *
+     * 每个节点的边先保留 base 中原有的边，再按插入顺序追加新边，因此和逐条 emplace_back 到邻接表的顺序一致。
+     *
+     * @param base 已冻结的图，可以为空指针
+     * @param reverse 为 true 时按目标节点分桶，生成反向图
+     *
+     * @return 新的 CSR 图
+     */
+    CSRGraph<T, V> build(const CSRGraph<T, V> *base = nullptr, bool reverse = false) const {
+        CSRGraph<T, V> g(n);
+        const auto &key = reverse ? dst : src;
+        const auto &val = reverse ? src : dst;
+
+        if (base && base->n == n) {
+            for (V u = 0; u < n; ++u) g.offsets[u + 1] = base->degree(u);
+        } else {
+            base = nullptr;
+        }
+        for (V k : key) ++g.offsets[k + 1];
+        for (V u = 0; u < n; ++u) g.offsets[u + 1] += g.offsets[u];
+
+        g.targets.resize(g.offsets[n]);
+        g.weights.resize(g.offsets[n]);
+        std::vector<std::size_t> pos(g.offsets.begin(), g.offsets.end() - 1);  // 每个节点的写入位置
+
+        if (base) {
+            for (V u = 0; u < n; ++u) {
+                for (const auto &[c, to] : (*base)[u]) {
+                    g.targets[pos[u]] = to;
+                    g.weights[pos[u]++] = c;
+                }
+            }
+        }
+        for (std::size_t i = 0; i < key.size(); ++i) {
+            auto p = pos[key[i]]++;
+            g.targets[p] = val[i];
+            g.weights[p] = cost[i];
+        }
+        return g;
+    }
+};
+
+/**
+ * @brief 生成 g 的反向图。pos 非空时记录 g 的第 i 条边在反向图中的位置，修改边权时用于同步两个方向。
+ */
+template <typename T, NodeId V>
+CSRGraph<T, V> reverse_graph(const CSRGraph<T, V> &g, std::vector<std::size_t> *pos = nullptr) {
+    const V n = g.n;
+    CSRGraph<T, V> gr(n);
+    for (V v : g.targets) ++gr.offsets[v + 1];
+    for (V v = 0; v < n; ++v) gr.offsets[v + 1] += gr.offsets[v];
+    gr.targets.resize(g.edge_count());
+    gr.weights.resize(g.edge_count());
+    if (pos) pos->resize(g.edge_count());
+    std::vector<std::size_t> next(gr.offsets.begin(), gr.offsets.end() - 1);
+    for (V u = 0; u < n; ++u)
+        for (std::size_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            auto p = next[g.targets[i]]++;
+            gr.targets[p] = u, gr.weights[p] = g.weights[i];
+            if (pos) (*pos)[i] = p;
+        }
+    return gr;
+}
+
+#endif
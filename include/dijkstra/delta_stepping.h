@@ -0,0 +1,181 @@
+#ifndef PATH_DELTA_STEPPING_H
+#define PATH_DELTA_STEPPING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.h"
+#include "dijkstra.h"
+#include "thread_pool.h"
+#include "weight.h"
+
+/**
+ * @brief 并行 Delta-Stepping 单源最短路。
+ *
+ * 节点按距离放入宽度为 delta 的桶中，按桶号从小到大处理：同一个桶内反复松弛轻边 (权重 <= delta) 直到桶为空，
+ * 再一次性松弛该桶所有节点的重边 (权重 > delta)。每一轮松弛是线程池上的一次 parallel_for，
+ * 每个工作线程把松弛成功的节点写入自己的桶缓冲区，距离数组通过 CAS 取最小值更新。
+ * 最终距离是 d[v] = min(d[u] + c) 的最小不动点，与 Dijkstra::dijkstra 逐位相同。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ */
+template <Weight T, NodeId V = std::uint32_t>
+struct DeltaStepping {
+    static constexpr T INF = infinity<T>();
+
+    V n;
+    T delta;  // 桶宽，<= 0 时在 finalize 时取平均边权
+    CSRGraph<T, V> g;
+    CSRBuilder<T, V> pending;
+    CSRGraph<T, V> light, heavy;  // 按 delta 拆分的轻边和重边
+    T split_delta = 0;            // light/heavy 拆分时使用的 delta
+
+    DeltaStepping(V N, T D = 0) : n(N), delta(D), g(N), pending(N), light(N), heavy(N) {}
+
+    bool check(V u) { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return;
+        pending.add(u, v, cost);
+    }
+
+    void add_bidir_edge(V u, V v, T cost) {
+        add_edge(u, v, cost);
+        add_edge(v, u, cost);
+    }
+
+    /**
+     * @brief 冻结图并按 delta 拆分轻边和重边，delta 改变后会重新拆分。
+     */
+    void finalize() {
+        bool changed = !pending.empty();
+        if (changed) {
+            g = pending.build(&g);
+            pending.clear();
+        }
+        if (!(T(0) < delta)) {
+            long double sum = 0;  // 以宽类型累加，边权之和超出 T 的范围时不会溢出
+            for (T c : g.weights) sum += c;
+            delta = g.weights.empty() ? T(1) : std::max<T>(T(1), T(sum / g.weights.size()));
+            changed = true;
+        }
+        if (!changed && split_delta == delta) return;
+        split_delta = delta;
+
+        CSRBuilder<T, V> lb(n), hb(n);
+        for (V u = 0; u < n; ++u)
+            for (const auto &[c, to] : g[u]) (c <= delta ? lb : hb).add(u, to, c);
+        light = lb.build();
+        heavy = hb.build();
+    }
+
+    /**
+     * @brief 计算从 s 出发到所有节点的最短距离，不可达为 INF。
+     *
+     * @param pool 执行松弛的线程池，调用线程作为其中的 0 号工作线程参与计算
+     */
+    std::vector<T> distances(V s, ThreadPool &pool) {
+        if (!check(s)) return {};
+        finalize();
+        const int p = pool.size();
+        constexpr std::size_t CHUNK = 64;
+
+        std::vector<std::atomic<T>> dist(n);
+        for (auto &d : dist) d.store(INF, std::memory_order_relaxed);
+        dist[s].store(0, std::memory_order_relaxed);
+
+        auto bucket = [&](T d) { return static_cast<std::size_t>(d / delta); };
+        // 原子地把 dist[v] 更新为 min(dist[v], nd)，成功时返回 true；未到达的节点距离为 infinity
+        auto relax = [&](V v, T nd) {
+            T old = dist[v].load(std::memory_order_relaxed);
+            while (nd < old)
+                if (dist[v].compare_exchange_weak(old, nd, std::memory_order_relaxed)) return true;
+            return false;
+        };
+
+        std::vector<std::vector<std::vector<V>>> bins(p);  // bins[工作线程][桶] 线程局部的松弛缓冲区
+        std::vector<V> frontier{s}, settled{s};            // 当前轮要扩展的节点，以及当前桶内已确定的节点
+        std::vector<std::uint32_t> frontier_mark(n, 0), settled_mark(n, 0);
+        std::uint32_t frontier_epoch = 1, settled_epoch = 1;
+        frontier_mark[s] = settled_mark[s] = 1;
+        std::size_t cur = 0;
+        bool heavy_phase = false, done = false;
+
+        // 从所有线程的缓冲区中取出桶 b 的节点，过滤重复和已经移到更小桶的节点
+        auto gather = [&](std::size_t b) {
+            frontier.clear();
+            ++frontier_epoch;
+            for (auto &local : bins) {
+                if (b >= local.size()) continue;
+                for (V v : local[b]) {
+                    if (frontier_mark[v] == frontier_epoch) continue;
+                    if (bucket(dist[v].load(std::memory_order_relaxed)) != b) continue;
+                    frontier_mark[v] = frontier_epoch;
+                    frontier.push_back(v);
+                }
+                local[b].clear();
+            }
+        };
+
+        // 每轮 parallel_for 结束后由调用线程执行，决定下一轮处理什么
+        auto advance = [&] {
+            if (!heavy_phase) {
+                gather(cur);
+                if (frontier.empty()) {
+                    heavy_phase = true;  // 桶内轻边松弛结束，接着松弛重边
+                    return;
+                }
+                for (V v : frontier)
+                    if (settled_mark[v] != settled_epoch) settled_mark[v] = settled_epoch, settled.push_back(v);
+                return;
+            }
+
+            heavy_phase = false;
+            settled.clear();
+            ++settled_epoch;
+            std::size_t last = 0;
+            for (auto &local : bins) last = std::max(last, local.size());
+            for (++cur; cur < last; ++cur) {
+                gather(cur);
+                if (!frontier.empty()) break;
+            }
+            if (frontier.empty()) {
+                done = true;
+                return;
+            }
+            for (V v : frontier) settled_mark[v] = settled_epoch, settled.push_back(v);
+        };
+
+        while (!done) {
+            const auto &graph = heavy_phase ? heavy : light;
+            const auto &items = heavy_phase ? settled : frontier;
+            pool.parallel_for((items.size() + CHUNK - 1) / CHUNK, [&](std::size_t chunk, int worker) {
+                auto &local = bins[worker];
+                const auto e = std::min((chunk + 1) * CHUNK, items.size());
+                for (auto i = chunk * CHUNK; i < e; ++i) {
+                    V u = items[i];
+                    T du = dist[u].load(std::memory_order_relaxed);
+                    for (const auto &[c, v] : graph[u]) {
+                        T nd = saturating_add(du, c);
+                        if (!relax(v, nd)) continue;
+                        auto k = bucket(nd);
+                        if (k >= local.size()) local.resize(k + 1);
+                        local[k].push_back(v);
+                    }
+                }
+            });
+            advance();
+        }
+
+        std::vector<T> result(n);
+        for (V v = 0; v < n; ++v) result[v] = dist[v].load(std::memory_order_relaxed);
+        return result;
+    }
+
+    std::vector<T> distances(V s) { return distances(s, default_thread_pool()); }
+};
+
+#endif
@@ -1,25 +1,56 @@
 #ifndef PATH_DIJKSTRA_H
 #define PATH_DIJKSTRA_H
-#include <doctest/doctest.h>
-#include <nanobench.h>
-#include <spdlog/spdlog.h>
 
 #include <algorithm>
-#include <queue>
-#include <set>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template <typename T>
+#include "compressed_graph.h"
+#include "connectivity.h"
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "shortest_path_tree.h"
+#include "thread_pool.h"
+#include "weight.h"
+#include "workspace.h"
+
+/**
+ * @brief 单向 Dijkstra。
+ *
+ * 不可达的距离为 INF (即 infinity<T>())，没有前驱的节点 (起点) 的前驱为 NONE (即 no_node<V>())。
+ *
+ * @tparam T 边权类型，任意非负的算术类型 (见 weight.h)；整数路径长度超出类型范围时视为不可达
+ * @tparam V 节点编号类型，uint32_t 或 uint64_t (见 NodeId)
+ * @tparam Q 优先队列策略，整数边权默认为基数堆，浮点边权默认为惰性删除的二叉堆，见 priority_queue.h
+ * @tparam S 统计策略，默认不统计，每次查询的统计数据保存在工作区的 stats 中，见 stats.h
+ * @tparam G 图的表示，默认为 CSRGraph，内存受限时可以用 CompressedGraph (见 compressed_graph.h)
+ */
+template <Weight T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>, typename S = NoStats,
+          typename G = CSRGraph<T, V>>
 struct Dijkstra {
-    const int INF = -1;
-    using E = std::pair<T, int>;             // 权重, 节点
+    static_assert(std::is_same_v<typename Q::node_type, V>, "queue node type must match V");
+    static constexpr T INF = infinity<T>();  // 不可达
+    static constexpr V NONE = no_node<V>();  // 没有节点
+    using E = std::pair<T, V>;               // 权重, 节点
     using P = std::pair<T, std::vector<E>>;  // 最短路径长度，具体路径
-
-    int n;                           // 节点数
-    std::vector<std::vector<E>> g;   // 邻接表
-    Dijkstra(int N) : n(N), g(N) {}  // 初始化
-
-    bool check(int u) { return u >= 0 && u < n; }
+    using Workspace = SearchWorkspace<T, Q, S>;
+    using Tree = ShortestPathTree<T, V>;
+
+    V n;                                       // 节点数
+    G g;                                       // 冻结后的邻接表
+    CSRBuilder<T, V> pending;                  // 尚未冻结的边
+    ConnectivityIndex<V> reach;                // g 的可达性索引，由 finalize 建立
+    bool index_reachability = false;           // 为 true 时 finalize 建立可达性索引
+    CSRGraph<T, V> gr;                         // 反向图，第一次 update_edge 时建立
+    std::vector<std::size_t> reverse_pos;      // g 的第 i 条边在 gr 中的位置
+    Dijkstra(V N) : n(N), g(N), pending(N) {}  // 初始化
+    explicit Dijkstra(CSRGraph<T, V> graph) : n(graph.n), g(std::move(graph)), pending(n) {}  // 直接使用已有的 CSR 图，如 map_csr_file 的结果
+    explicit Dijkstra(G graph) requires(!std::is_same_v<G, CSRGraph<T, V>>) : n(graph.n), g(std::move(graph)), pending(n) {}  // 已编码的压缩图
+
+    bool check(V u) { return u < n; }
 
     /**
      * @brief 在图中添加一条从节点 u 到节点 v 的边，边的权值为 cost。
@@ -28,9 +59,9 @@ struct Dijkstra {
      * @param v 目标节点
      * @param cost 边的权值
      */
-    void add_edge(int u, int v, T cost) {
+    void add_edge(V u, V v, T cost) {
         if (!check(u) || !check(v)) return;
-        g[u].emplace_back(cost, v);
+        pending.add(u, v, cost);
     }
 
     /**
@@ -41,105 +72,78 @@ struct Dijkstra {
      * @param v 节点 v
      * @param cost 边的权重
      */
-    void add_bidir_edge(int u, int v, T cost) {
+    void add_bidir_edge(V u, V v, T cost) {
         if (!check(u) || !check(v)) return;
         add_edge(u, v, cost);
         add_edge(v, u, cost);
     }
 
     /**
-     * @brief 使用 Dijkstra 算法计算从起点 s
-     * 到所有其他顶点的最短路径。如果某个顶点不可达，则返回 INF。
+     * @brief 将 add_edge 缓冲的边冻结为 CSR 邻接表，并 (重新) 建立可达性索引。
+     *
+     * 查询前会自动调用；多线程并发查询前需要先手动调用一次。
+     */
+    void finalize() {
+        if (!pending.empty()) {
+            merge_pending(g, pending);
+            pending.clear();
+            reach = {};
+            gr = {};
+        }
+        if (index_reachability && reach.empty()) reach = ConnectivityIndex<V>(to_csr(g));
+    }
+
+    /**
+     * @brief 可达性索引判定 t 不可达时返回 true，此时查询无需搜索。
+     */
+    bool unreachable(V s, V t) const { return !reach.empty() && !reach.reachable(s, t); }
+
+    /**
+     * @brief 使用 Dijkstra 算法计算从起点 s 到所有其他顶点的最短路径树。
      *
      * @param s 起点
+     * @param ws 查询工作区，缺省时使用当前线程的工作区
      *
-     * @return 返回一个 vector，其中每个元素表示从起点 s
-     * 到对应顶点的最短路径长度
+     * @return 每个顶点的距离和前驱，不可达为 INF；越界时返回空树。路径通过 path_to 按需展开
      */
-    std::vector<P> dijkstra(int s) {  // unreachable : INF
+    Tree dijkstra(V s, Workspace &ws) {
         if (!check(s)) return {};
-        std::vector<T> d(n, T(INF));
-        std::priority_queue<E, std::vector<E>, std::greater<E>> pq;
-        std::vector<E> prev(n, {T(INF), INF});  // 记录cost和前驱节点
-
-        d[s] = 0;
-        prev[s] = {0, INF};
-        pq.emplace(0, s);
-
-        while (!pq.empty()) {
-            auto [cost, from] = pq.top();
-            pq.pop();
-
-            if (d[from] < cost) continue;  // 不会重复处理那些已知有更短路径的顶点
-
-            for (const auto &[c, to] : g[from]) {  // 遍历 u 的所有邻接点
-                if (d[to] == T(INF) || cost + c < d[to]) {
-                    d[to] = cost + c;
-                    prev[to] = {c, from};  // 更新代价和前驱节点
-                    pq.emplace(d[to], to);
-                }
-            }
-        }
-
-        std::vector<P> short_paths(n);
-        for (int i = 0; i < n; ++i) {
-            short_paths[i] = {d[i], {}};
-            if (d[i] == T(INF)) continue;  // 不可达
-            auto cur = i;
-            while (cur != INF) {
-                short_paths[i].second.emplace_back(prev[cur].first, cur);  // 记录路径
-                cur = prev[cur].second;
-            }
-            std::reverse(short_paths[i].second.begin(), short_paths[i].second.end());
-        }
-        return short_paths;
+        finalize();
+        search(s, NONE, ws);
+        [[maybe_unused]] auto timer = ws.stats.phase(Phase::Path);
+        return {s, n, ws};
     }
 
+    Tree dijkstra(V s) { return dijkstra(s, thread_workspace<T, Q, 0, S>()); }
+
     /**
      * @brief 使用 Dijkstra 算法计算从起点 s 到终点 t 的最短路径及其代价。
      *
      * @param s 起点
      * @param t 终点
+     * @param ws 查询工作区，缺省时使用当前线程的工作区
      *
      * @return 返回包含最短路径代价和路径的 std::pair 对象
      */
-    P shortest_path(int s, int t) {
-        if (!check(s) || !check(t)) return {T(INF), {}};  // 检查越界
-        if (s == t) return {T(0), {{0, s}}};              // 起点和终点相同
-
-        std::vector<T> d(n, T(INF));
-        std::vector<E> prev(n, {T(INF), INF});  // 记录cost和前驱节点
-
-        std::priority_queue<E, std::vector<E>, std::greater<E>> pq;  // 最小堆
-
-        d[s] = 0;
-        prev[s] = {0, INF};
-        pq.emplace(0, s);
-
-        while (!pq.empty()) {
-            auto [cost, from] = pq.top();
-            pq.pop();
-
-            if (d[from] < cost) continue;  // 不会重复处理那些已知有更短路径的顶点
-
-            if (from == t) break;                  // 终点已找到，提前退出
-            for (const auto &[c, to] : g[from]) {  // 遍历 u 的所有邻接点
-                if (d[to] == T(INF) || cost + c < d[to]) {
-                    d[to] = cost + c;
-                    prev[to] = {c, from};  // 更新代价和前驱节点
-                    pq.emplace(d[to], to);
-                }
-            }
+    P shortest_path(V s, V t, Workspace &ws) {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        finalize();
+        if (unreachable(s, t)) {  // 索引判定不可达，清空工作区后直接返回
+            ws.reset(n);
+            return {INF, {}};
         }
+        search(s, t, ws);
 
-        T total_cost = d[t];
-        if (total_cost == T(INF)) return {total_cost, {}};  // 未找到路径
+        if (!ws.reached(t)) return {INF, {}};  // 未找到路径
+        [[maybe_unused]] auto timer = ws.stats.phase(Phase::Path);
+        T total_cost = ws.dist[t];
 
         std::vector<E> short_path;
         auto cur = t;
-        while (cur != INF) {                                // 回溯路径，直到没有前驱节点
-            short_path.emplace_back(prev[cur].first, cur);  // 记录路径
-            cur = prev[cur].second;
+        while (cur != NONE) {                                  // 回溯路径，直到没有前驱节点
+            short_path.emplace_back(ws.prev[cur].first, cur);  // 记录路径
+            cur = ws.prev[cur].second;
         }
 
         std::reverse(short_path.begin(), short_path.end());
@@ -147,132 +151,278 @@ struct Dijkstra {
         return {total_cost, short_path};
     }
 
-    T shortest_dist(int s, int t) {
-        if (!check(s) || !check(t)) return T(INF);  // 检查越界
-        if (s == t) return T(0);                    // 起点和终点相同
+    P shortest_path(V s, V t) { return shortest_path(s, t, thread_workspace<T, Q, 0, S>()); }
+
+    T shortest_dist(V s, V t, Workspace &ws) {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        finalize();
+        if (unreachable(s, t)) {
+            ws.reset(n);
+            return INF;
+        }
+        search(s, t, ws);
+        return ws.get(t, INF);
+    }
 
-        std::vector<T> d(n, T(INF));
-        std::priority_queue<E, std::vector<E>, std::greater<E>> pq;  // 最小堆
+    T shortest_dist(V s, V t) { return shortest_dist(s, t, thread_workspace<T, Q, 0, S>()); }
 
-        d[s] = 0;
-        pq.emplace(0, s);
+    /**
+     * @brief 把所有 u -> v 边的边权改为 cost (拓扑不变，可达性索引仍然有效)，并就地修复 trees 中的最短路径树。
+     *
+     * @return 是否存在这样的边，不存在时图和树都不变
+     */
+    bool update_edge(V u, V v, T cost, std::vector<Tree> &trees)
+        requires std::is_same_v<G, CSRGraph<T, V>>
+    {
+        if (!check(u) || !check(v)) return false;
+        finalize();
+        if (gr.n != n) gr = reverse_graph(g, &reverse_pos);
+        bool found = false;
+        const auto &cg = std::as_const(g);  // 只读 offsets / targets，借用 mmap 文件时只复制 weights
+        for (std::size_t i = cg.offsets[u]; i < cg.offsets[u + 1]; ++i)
+            if (cg.targets[i] == v) g.weights[i] = cost, gr.weights[reverse_pos[i]] = cost, found = true;
+        if (found)
+            for (auto &tree : trees) repair(tree, u, v, thread_workspace<T, Q, 0, S>());
+        return found;
+    }
 
-        while (!pq.empty()) {
-            auto [cost, from] = pq.top();
-            pq.pop();
+    bool update_edge(V u, V v, T cost, Tree &tree) {
+        std::vector<Tree> trees;
+        trees.push_back(std::move(tree));
+        bool found = update_edge(u, v, cost, trees);
+        tree = std::move(trees.front());
+        return found;
+    }
 
-            if (d[from] < cost) continue;  // 不会重复处理那些已知有更短路径的顶点
+    bool update_edge(V u, V v, T cost) {
+        std::vector<Tree> none;
+        return update_edge(u, v, cost, none);
+    }
 
-            if (from == t) break;                  // 终点已找到，提前退出
-            for (const auto &[c, to] : g[from]) {  // 遍历 u 的所有邻接点
-                if (d[to] == T(INF) || cost + c < d[to]) {
-                    d[to] = cost + c;
-                    pq.emplace(d[to], to);
-                }
+    /**
+     * @brief u -> v 的边权变化后修复最短路径树 (Ramalingam-Reps)，只访问距离发生变化的节点及其邻边。
+     *
+     * 变短时从 v 开始做一次只松弛变短节点的 Dijkstra。变长且 u -> v 是树边时分两步：
+     *   1. 按原距离从小到大检查 v 的子树，节点有距离更小、未受影响的入邻居能以相同距离到达时不受影响，
+     *      否则受影响 (距离暂记为 INF)，继续检查它的子节点。零权入边不作为依据，最多多算几个受影响的节点。
+     *   2. 受影响的节点先取未受影响的入邻居给出的最好距离，再在受影响的节点之间做 Dijkstra。
+     * tree 必须是当前图 (修改 u -> v 之外) 上的最短路径树。
+     */
+    void repair(Tree &tree, V u, V v, Workspace &ws)
+        requires std::is_same_v<G, CSRGraph<T, V>>
+    {
+        if (!tree.reached(u) || tree.size() != n) return;  // u 不可达时这条边不影响任何距离
+        auto &dist = tree.dist;
+        auto &prev = tree.prev;
+        T cost = INF;  // 多重边取最小的边权
+        for (const auto &[c, to] : g[u])
+            if (to == v && c < cost) cost = c;
+        ws.reset(n);
+        auto at = [&](V x) { return tree.reached(x) ? dist[x] : INF; };
+
+        auto relax = [&] {  // 从队列中的节点开始，只更新变短的节点
+            while (!ws.pq.empty()) {
+                auto [d, x] = ws.pq.top();
+                ws.pq.pop();
+                if (dist[x] < d) continue;
+                ++ws.settled;
+                for (const auto &[c, y] : g[x])
+                    if (T cand = saturating_add(d, c); cand < at(y)) {
+                        dist[y] = cand, prev[y] = {c, x};
+                        ws.pq.push(cand, y);
+                    }
             }
+        };
+
+        if (T cand = saturating_add(dist[u], cost); cand < at(v)) {  // 变短
+            dist[v] = cand, prev[v] = {cost, u};
+            ws.pq.push(dist[v], v);
+            relax();
+            return;
+        }
+        if (prev[v].second != u || !(prev[v].first < cost)) return;  // 不是变长的树边
+
+        std::vector<V> affected;
+        ws.set(v, dist[v]);
+        ws.pq.push(dist[v], v);
+        while (!ws.pq.empty()) {
+            auto [d, x] = ws.pq.top();
+            ws.pq.pop();
+            bool supported = false;
+            for (const auto &[c, w] : gr[x])
+                if (tree.reached(w) && dist[w] < d && saturating_add(dist[w], c) == d) {
+                    prev[x] = {c, w};
+                    supported = true;
+                    break;
+                }
+            if (supported) continue;
+            affected.push_back(x);
+            dist[x] = INF;
+            for (const auto &[c, y] : g[x])  // 子节点的父节点受影响，需要检查；多重边只入队一次
+                if (prev[y].second == x && tree.reached(y) && !ws.reached(y)) ws.set(y, dist[y]), ws.pq.push(dist[y], y);
         }
 
-        return d[t];
+        ws.reset(n);
+        for (V x : affected) {
+            prev[x] = {0, NONE};
+            for (const auto &[c, w] : gr[x])
+                if (T cand = tree.reached(w) ? saturating_add(dist[w], c) : INF; cand < at(x))
+                    dist[x] = cand, prev[x] = {c, w};
+            if (tree.reached(x)) ws.pq.push(dist[x], x);
+        }
+        relax();
     }
-};
 
-TEST_CASE("DijkstraTest1") {
-    // 有向图
-    auto dijkstra = std::make_unique<Dijkstra<int>>(6);
-    dijkstra->add_edge(0, 1, 1);
-    dijkstra->add_edge(1, 2, 2);
-    dijkstra->add_edge(2, 3, 2);
-    dijkstra->add_edge(3, 4, 1);
-    dijkstra->add_edge(1, 3, 3);
-
-    SUBCASE("起点终点之间有边") {
-        auto ans = dijkstra->shortest_path(0, 4);
-        CHECK(ans.first == 5);
+    void repair(Tree &tree, V u, V v) { repair(tree, u, v, thread_workspace<T, Q, 0, S>()); }
+
+    /**
+     * @brief 距离起点不超过 radius 的所有节点 (等时圈)，第一个超出 radius 的节点出队时停止搜索。
+     *
+     * @param sources 一个或多个起点，多个起点时为到最近起点的距离 (合并的服务范围)
+     *
+     * @return (距离, 节点) 列表，按距离递增 (即确定的顺序)；不展开路径，需要时用 dijkstra 或 shortest_path
+     */
+    std::vector<E> within(std::span<const V> sources, T radius, Workspace &ws) {
+        std::vector<E> out;
+        finalize();
+        search_until(sources, ws, [&](V u) {
+            if (radius < ws.dist[u]) return true;
+            out.emplace_back(ws.dist[u], u);
+            return false;
+        });
+        return out;
     }
-    SUBCASE("起点终点之间没有边") {
-        auto ans = dijkstra->shortest_path(0, 5);
-        CHECK(ans.first == -1);
+
+    std::vector<E> within(std::span<const V> sources, T radius) {
+        return within(sources, radius, thread_workspace<T, Q, 0, S>());
     }
-    SUBCASE("起点终点越界") {
-        auto ans = dijkstra->shortest_path(0, 6);
-        CHECK(ans.first == -1);
+    std::vector<E> within(V s, T radius, Workspace &ws) { return within(std::span<const V>(&s, 1), radius, ws); }
+    std::vector<E> within(V s, T radius) { return within(s, radius, thread_workspace<T, Q, 0, S>()); }
+
+    /**
+     * @brief 离起点最近的 k 个满足 pred(u) 的节点，找到第 k 个时停止搜索。
+     *
+     * @param sources 一个或多个起点，起点本身满足 pred 时也计入
+     *
+     * @return (距离, 节点) 列表，按距离递增，可达的满足条件的节点不足 k 个时全部返回
+     */
+    template <typename Pred>
+    std::vector<E> k_nearest(std::span<const V> sources, std::size_t k, Pred &&pred, Workspace &ws) {
+        std::vector<E> out;
+        if (k == 0) return out;
+        finalize();
+        search_until(sources, ws, [&](V u) {
+            if (pred(u)) out.emplace_back(ws.dist[u], u);
+            return out.size() == k;
+        });
+        return out;
     }
-    SUBCASE("起点终点相同") {
-        auto ans = dijkstra->shortest_path(0, 0);
-        CHECK(ans.first == 0);
+
+    template <typename Pred>
+    std::vector<E> k_nearest(std::span<const V> sources, std::size_t k, Pred &&pred) {
+        return k_nearest(sources, k, pred, thread_workspace<T, Q, 0, S>());
     }
-    SUBCASE("所有结果") {
-        std::vector<std::pair<int, std::vector<std::pair<int, int>>>> except_paths = {
-            {0, {{0, 0}}},
-            {1, {{0, 0}, {1, 1}}},
-            {3, {{0, 0}, {1, 1}, {2, 2}}},
-            {4, {{0, 0}, {1, 1}, {3, 3}}},
-            {5, {{0, 0}, {1, 1}, {3, 3}, {1, 4}}},
-            {-1, {}},
-        };
 
-        auto short_paths = dijkstra->dijkstra(0);
-        CHECK(short_paths == except_paths);
+    template <typename Pred>
+    std::vector<E> k_nearest(V s, std::size_t k, Pred &&pred) {
+        return k_nearest(std::span<const V>(&s, 1), k, pred);
     }
-}
-
-TEST_CASE("DijkstraTest2") {
-    Dijkstra<int> d(7);
-    d.add_bidir_edge(0, 1, 2);
-    d.add_bidir_edge(0, 2, 6);
-    d.add_bidir_edge(1, 3, 5);
-    d.add_bidir_edge(2, 3, 8);
-    d.add_bidir_edge(3, 4, 10);
-    d.add_bidir_edge(3, 5, 15);
-    d.add_bidir_edge(4, 5, 3);
-    d.add_bidir_edge(4, 6, 2);
-    d.add_bidir_edge(5, 6, 6);
-
-    SUBCASE("Test 起点1") {
-        auto ans = d.shortest_path(0, 6);
-        std::vector<std::pair<int, std::vector<std::pair<int, int>>>> except_paths = {
-            {0, {{0, 0}}},
-            {2, {{0, 0}, {2, 1}}},
-            {6, {{0, 0}, {6, 2}}},
-            {7, {{0, 0}, {2, 1}, {5, 3}}},
-            {17, {{0, 0}, {2, 1}, {5, 3}, {10, 4}}},
-            {20, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}}},
-            {19, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {2, 6}}},
-        };
-        auto short_paths = d.dijkstra(0);
-        CHECK(short_paths == except_paths);
+
+    std::vector<E> k_nearest(V s, std::size_t k) {
+        return k_nearest(s, k, [](V) { return true; });
     }
 
-    SUBCASE("Test 起点2") {
-        std::vector<std::pair<int, std::vector<std::pair<int, int>>>> except_paths = {
-            {6, {{0, 2}, {6, 0}}},
-            {8, {{0, 2}, {6, 0}, {2, 1}}},
-            {0, {{0, 2}}},
-            {8, {{0, 2}, {8, 3}}},
-            {18, {{0, 2}, {8, 3}, {10, 4}}},
-            {21, {{0, 2}, {8, 3}, {10, 4}, {3, 5}}},
-            {20, {{0, 2}, {8, 3}, {10, 4}, {2, 6}}},
-        };
+    /**
+     * @brief 计算 sources × targets 的距离矩阵，按行优先写入连续的缓冲区，不可达或越界为 INF。
+     *
+     * 每个起点做一次一对多搜索，所有终点都确定后提前退出；各行由线程池并行计算，每个工作线程复用自己的工作区。
+     *
+     * @return 长度为 sources.size() * targets.size() 的数组，第 i 行第 j 列为 sources[i] 到 targets[j] 的距离
+     */
+    std::vector<T> distance_matrix(const std::vector<V> &sources, const std::vector<V> &targets, ThreadPool &pool) {
+        finalize();
+        const std::size_t cols = targets.size();
+        std::vector<T> out(sources.size() * cols, INF);
+
+        std::vector<char> is_target(n, 0);
+        std::size_t unique_targets = 0;
+        for (V t : targets)
+            if (check(t) && !is_target[t]) is_target[t] = 1, ++unique_targets;
+
+        pool.parallel_for(sources.size(), [&](std::size_t i, int) {
+            V s = sources[i];
+            if (!check(s) || unique_targets == 0) return;
+            auto &ws = thread_workspace<T, Q, 0, S>();
+            std::size_t remaining = unique_targets;
+            search_until(s, ws, [&](V u) { return is_target[u] && --remaining == 0; });
+
+            T *row = out.data() + i * cols;
+            for (std::size_t j = 0; j < cols; ++j)
+                if (check(targets[j])) row[j] = ws.get(targets[j], INF);
+        });
+        return out;
+    }
+
+    std::vector<T> distance_matrix(const std::vector<V> &sources, const std::vector<V> &targets) {
+        return distance_matrix(sources, targets, default_thread_pool());
+    }
+
+    /**
+     * @brief 从 s 出发的 Dijkstra 搜索，结果保存在 ws 中；t 为 NONE 时搜索整个可达区域，否则到达 t 后提前退出。
+     */
+    void search(V s, V t, Workspace &ws) {
+        search_until(s, ws, [t](V u) { return u == t; });
+    }
 
-        auto short_paths = d.dijkstra(2);
-        CHECK(short_paths == except_paths);
+    /**
+     * @brief 从 s 出发的 Dijkstra 搜索，每确定一个节点 u 调用一次 stop(u)，返回 true 时提前退出。
+     */
+    template <typename Stop>
+    void search_until(V s, Workspace &ws, Stop &&stop) {
+        search_until(std::span<const V>(&s, 1), ws, stop);
     }
-}
-
-TEST_CASE("DijkstraTest3") {
-    Dijkstra<int> d(9);
-    d.add_edge(0, 1, 1);
-    d.add_edge(0, 5, 4);
-    d.add_edge(0, 4, 8);
-    d.add_edge(1, 2, 1);
-    d.add_edge(2, 3, 1);
-    d.add_edge(3, 7, 1);
-    d.add_edge(7, 8, 2);
-    d.add_edge(5, 8, 1);
-    d.add_edge(4, 6, 2);
-    d.add_edge(6, 8, 6);
-
-    ankerl::nanobench::Bench().run("Dijkstra", [&] { d.shortest_dist(0, 8); });
-}
+
+    /**
+     * @brief 从多个起点同时出发 (距离均为 0) 的 Dijkstra 搜索，越界和重复的起点被忽略。
+     */
+    template <typename Stop>
+    void search_until(std::span<const V> sources, Workspace &ws, Stop &&stop) {
+        {
+            [[maybe_unused]] auto timer = ws.stats.phase(Phase::Init);
+            ws.reset(n);
+            for (V s : sources) {
+                if (!check(s) || ws.reached(s)) continue;
+                ws.set(s, 0, {0, NONE});
+                ws.pq.push(0, s);
+                ws.stats.on_push();
+            }
+        }
+
+        [[maybe_unused]] auto timer = ws.stats.phase(Phase::Search);
+        while (!ws.pq.empty()) {
+            auto [cost, from] = ws.pq.top();
+            ws.pq.pop();
+
+            bool stale = ws.dist[from] < cost;
+            ws.stats.on_pop(stale);
+            if (stale) continue;  // 不会重复处理那些已知有更短路径的顶点
+            ++ws.settled;
+            ws.stats.on_settle();
+
+            if (stop(from)) break;                 // 终点已找到，提前退出
+            for (const auto &[c, to] : g[from]) {  // 遍历 u 的所有邻接点
+                ws.stats.on_scan();
+                T cand = saturating_add(cost, c);  // 溢出时为 infinity，不会松弛
+                if (cand < ws.get(to, infinity<T>())) {
+                    ws.set(to, cand, {c, from});  // 更新代价和前驱节点
+                    ws.pq.push(cand, to);
+                    ws.stats.on_relax();
+                    ws.stats.on_push();
+                }
+            }
+        }
+    }
+};
 
 #endif
@@ -0,0 +1,294 @@
+#ifndef PATH_GRAPH_FILE_H
+#define PATH_GRAPH_FILE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PATH_GRAPH_FILE_MMAP 1
+#endif
+
+#include "csr_graph.h"
+#include "weight.h"
+
+/**
+ * 二进制 CSR 图文件，小端序，所有段按 64 字节对齐，可以 mmap 后直接查询：
+ *
+ *   CSRFileHeader                     64 字节
+ *   正向图 offsets  (n + 1) x uint64
+ *   正向图 targets  m x uint32 (flags 含 CSR_FILE_WIDE_IDS 时为 uint64)
+ *   正向图 weights  m x weight_size
+ *   反向图 offsets / targets / weights (flags 含 CSR_FILE_REVERSE 时存在)
+ *
+ * 节点编号的宽度与 CSRGraph 的 V 相同，读入时必须一致。
+ * 文件格式或读写失败时抛出 std::runtime_error。
+ */
+
+constexpr char CSR_FILE_MAGIC[8] = {'S', 'P', 'C', 'S', 'R', 0, 0, 0};
+constexpr std::uint32_t CSR_FILE_VERSION = 1;
+constexpr std::uint32_t CSR_FILE_REVERSE = 1;   // flags：包含反向图
+constexpr std::uint32_t CSR_FILE_WIDE_IDS = 2;  // flags：节点编号为 uint64
+
+struct CSRFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t weight_kind;  // 'i' 有符号整数，'u' 无符号整数，'f' 浮点数
+    std::uint32_t weight_size;  // 边权的字节数
+    std::uint32_t flags;
+    std::uint64_t n;  // 节点数
+    std::uint64_t m;  // 每个方向的边数
+    std::uint64_t reserved[3];
+};
+static_assert(sizeof(CSRFileHeader) == 64);
+
+template <typename T>
+constexpr std::uint32_t csr_weight_kind() {
+    return std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i' : 'u';
+}
+
+inline std::uint64_t csr_align(std::uint64_t bytes) { return (bytes + 63) / 64 * 64; }
+
+/**
+ * @brief 一个方向的图在文件中占用的字节数。
+ */
+inline std::uint64_t csr_section_bytes(std::uint64_t n, std::uint64_t m, std::uint64_t id_size, std::uint64_t weight_size) {
+    return csr_align((n + 1) * 8) + csr_align(m * id_size) + csr_align(m * weight_size);
+}
+
+/**
+ * @brief 将正向图 (以及可选的反向图) 写入 path。两个图的节点数和边数必须相同。
+ */
+template <typename T, NodeId V>
+void write_csr_file(const std::string &path, const CSRGraph<T, V> &forward, const CSRGraph<T, V> *reverse = nullptr) {
+    static_assert(std::is_arithmetic_v<T>, "CSR files only store arithmetic weights");
+    if constexpr (std::endian::native != std::endian::little)
+        throw std::runtime_error("CSR files can only be written on little-endian hosts");
+    if (reverse && (reverse->n != forward.n || reverse->edge_count() != forward.edge_count()))
+        throw std::runtime_error("reverse graph does not match forward graph");
+
+    CSRFileHeader h{};
+    std::memcpy(h.magic, CSR_FILE_MAGIC, sizeof(h.magic));
+    h.version = CSR_FILE_VERSION;
+    h.weight_kind = csr_weight_kind<T>();
+    h.weight_size = sizeof(T);
+    h.flags = (reverse ? CSR_FILE_REVERSE : 0) | (sizeof(V) == 8 ? CSR_FILE_WIDE_IDS : 0);
+    h.n = forward.n;
+    h.m = forward.edge_count();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("cannot open " + path + " for writing");
+    auto write = [&](const void *p, std::uint64_t bytes) {
+        static const char zero[64] = {};
+        out.write(static_cast<const char *>(p), bytes);
+        out.write(zero, csr_align(bytes) - bytes);
+    };
+    auto write_graph = [&](const CSRGraph<T, V> &g) {
+        std::vector<std::uint64_t> offsets(g.offsets.begin(), g.offsets.end());
+        write(offsets.data(), offsets.size() * 8);
+        write(g.targets.data(), g.targets.size() * sizeof(V));
+        write(g.weights.data(), g.weights.size() * sizeof(T));
+    };
+    write(&h, sizeof(h));
+    write_graph(forward);
+    if (reverse) write_graph(*reverse);
+    if (!out.flush()) throw std::runtime_error("failed to write " + path);
+}
+
+/**
+ * @brief 只读映射的整个文件，析构时解除映射。没有 mmap 的平台上退化为读入内存。
+ */
+struct MappedFile {
+    const char *data = nullptr;
+    std::size_t size = 0;
+    std::vector<char> buffer;  // 无 mmap 时的后备存储
+
+    explicit MappedFile(const std::string &path) {
+#ifdef PATH_GRAPH_FILE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        void *p = size ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : nullptr;
+        ::close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("cannot mmap " + path);
+        data = static_cast<const char *>(p);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        buffer.assign(std::istreambuf_iterator<char>(in), {});
+        data = buffer.data(), size = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef PATH_GRAPH_FILE_MMAP
+        if (data) ::munmap(const_cast<char *>(data), size);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+};
+
+/**
+ * @brief 映射后的图，forward / reverse 的数组直接借用文件内容，拷贝给引擎时不复制数据。
+ */
+template <typename T, NodeId V = std::uint32_t>
+struct MappedGraph {
+    CSRGraph<T, V> forward, reverse;
+    bool has_reverse = false;
+};
+
+/**
+ * @brief mmap 一个 CSR 文件。validate 为 true 时检查 offsets 单调且 targets 不越界，需要读遍整个文件；
+ * 对可信的文件传 false 可以做到只按需读取页面。
+ */
+template <typename T, NodeId V = std::uint32_t>
+MappedGraph<T, V> map_csr_file(const std::string &path, bool validate = true) {
+    static_assert(std::is_arithmetic_v<T>, "CSR files only store arithmetic weights");
+    if constexpr (std::endian::native != std::endian::little)
+        throw std::runtime_error("CSR files can only be mapped on little-endian hosts");
+
+    auto file = std::make_shared<const MappedFile>(path);
+    CSRFileHeader h;
+    if (file->size < sizeof(h)) throw std::runtime_error(path + ": not a CSR file");
+    std::memcpy(&h, file->data, sizeof(h));
+    if (std::memcmp(h.magic, CSR_FILE_MAGIC, sizeof(h.magic)) != 0) throw std::runtime_error(path + ": not a CSR file");
+    if (h.version != CSR_FILE_VERSION)
+        throw std::runtime_error(path + ": unsupported CSR file version " + std::to_string(h.version));
+    if (h.weight_kind != csr_weight_kind<T>() || h.weight_size != sizeof(T))
+        throw std::runtime_error(path + ": weight type does not match");
+    if (bool(h.flags & CSR_FILE_WIDE_IDS) != (sizeof(V) == 8))
+        throw std::runtime_error(path + ": node id width does not match");
+    // n 个节点的编号为 0..n-1，no_node<V>() 保留给“没有节点”；先用文件大小限制 m，下面计算段大小时的乘法才不会溢出
+    if (h.n >= no_node<V>() || h.n > (file->size - sizeof(h)) / 8) throw std::runtime_error(path + ": too many nodes");
+    if (h.m > (file->size - sizeof(h)) / (sizeof(V) + sizeof(T))) throw std::runtime_error(path + ": truncated");
+
+    const bool has_reverse = h.flags & CSR_FILE_REVERSE;
+    const std::uint64_t section = csr_section_bytes(h.n, h.m, sizeof(V), sizeof(T));
+    if (file->size < sizeof(h) + section * (has_reverse ? 2 : 1)) throw std::runtime_error(path + ": truncated");
+
+    auto load = [&](std::uint64_t pos) {
+        CSRGraph<T, V> g;
+        g.n = static_cast<V>(h.n);
+        const char *base = file->data + pos;
+        const char *targets = base + csr_align((h.n + 1) * 8);
+        const char *weights = targets + csr_align(h.m * sizeof(V));
+        if constexpr (sizeof(std::size_t) == 8) {
+            g.offsets = CSRArray<std::size_t>::borrow(reinterpret_cast<const std::size_t *>(base), h.n + 1, file);
+        } else {  // 32 位平台上 offsets 需要转换
+            g.offsets = CSRArray<std::size_t>(h.n + 1);
+            for (std::uint64_t i = 0; i <= h.n; ++i) {
+                std::uint64_t v;
+                std::memcpy(&v, base + i * 8, 8);
+                g.offsets[i] = static_cast<std::size_t>(v);
+            }
+        }
+        g.targets = CSRArray<V>::borrow(reinterpret_cast<const V *>(targets), h.m, file);
+        g.weights = CSRArray<T>::borrow(reinterpret_cast<const T *>(weights), h.m, file);
+
+        if (validate) {  // 通过 const 引用读取，避免触发 CSRArray 的复制
+            const auto &off = g.offsets;
+            bool ok = off[0] == 0 && off[h.n] == h.m;
+            for (std::uint64_t u = 0; ok && u < h.n; ++u) ok = off[u] <= off[u + 1];
+            ok = ok && std::all_of(g.targets.begin(), g.targets.end(), [&](V v) { return v < g.n; });
+            if (!ok) throw std::runtime_error(path + ": corrupt CSR data");
+        }
+        return g;
+    };
+
+    MappedGraph<T, V> mg;
+    mg.forward = load(sizeof(h));
+    if (has_reverse) mg.reverse = load(sizeof(h) + section), mg.has_reverse = true;
+    return mg;
+}
+
+/**
+ * @brief 从流中逐行读取 DIMACS 最短路挑战赛的 .gr 文件，大文件请使用 graph_loader.h 的并行加载器：
+ *   c 注释
+ *   p sp <n> <m>
+ *   a <u> <v> <w>    节点编号从 1 开始
+ */
+template <typename T, NodeId V = std::uint32_t>
+CSRBuilder<T, V> read_dimacs(std::istream &in) {
+    CSRBuilder<T, V> b;
+    bool header = false;
+    std::string line;
+    for (std::size_t line_no = 1; std::getline(in, line); ++line_no) {
+        if (line.empty() || line[0] == 'c') continue;
+        auto fail = [&](const char *what) {
+            throw std::runtime_error("DIMACS line " + std::to_string(line_no) + ": " + what);
+        };
+        std::istringstream ls(line);
+        char kind = 0;
+        if (!(ls >> kind)) continue;  // 只有空白 (包括 CRLF 换行留下的 \r) 的行
+        if (kind == 'p') {
+            std::string format;
+            long long n, m;
+            if (!(ls >> format >> n >> m) || format != "sp" || n < 0 || std::uint64_t(n) >= no_node<V>() || m < 0)
+                fail("bad problem line");
+            b = CSRBuilder<T, V>(static_cast<V>(n));
+            const auto hint = static_cast<std::size_t>(std::min<long long>(m, 1 << 20));  // m 来自输入，不可信
+            b.src.reserve(hint), b.dst.reserve(hint), b.cost.reserve(hint);
+            header = true;
+        } else if (kind == 'a') {
+            long long u, v;
+            T w;
+            if (!header || !(ls >> u >> v >> std::ws) || u < 1 || v < 1 || std::uint64_t(u) > b.n || std::uint64_t(v) > b.n)
+                fail("bad arc");
+            // 无符号类型的 >> 会把 "-5" 回绕成很大的数，因此先看符号
+            if (ls.peek() == '-' || !(ls >> w) || !(w >= T(0))) fail("bad or negative arc weight");
+            b.add(static_cast<V>(u - 1), static_cast<V>(v - 1), w);
+        }
+    }
+    if (!header) throw std::runtime_error("DIMACS input has no problem line");
+    return b;
+}
+
+/**
+ * @brief 读取纯文本边表，每行 "u v w"，节点编号从 0 开始，# 开头的行为注释；节点数取最大编号 + 1。
+ */
+template <typename T, NodeId V = std::uint32_t>
+CSRBuilder<T, V> read_edge_list(std::istream &in) {
+    CSRBuilder<T, V> b;
+    long long max_id = -1;
+    std::string line;
+    for (std::size_t line_no = 1; std::getline(in, line); ++line_no) {
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        std::istringstream ls(line);
+        long long u, v;
+        T w;
+        auto fail = [&](const char *what) {
+            throw std::runtime_error("edge list line " + std::to_string(line_no) + ": " + what);
+        };
+        // 最大编号 + 1 为节点数，不能达到 no_node<V>()
+        if (!(ls >> u >> v >> std::ws) || u < 0 || v < 0 || std::uint64_t(u) + 1 >= no_node<V>() ||
+            std::uint64_t(v) + 1 >= no_node<V>())
+            fail("bad edge");
+        if (ls.peek() == '-' || !(ls >> w) || !(w >= T(0))) fail("bad or negative edge weight");
+        b.add(static_cast<V>(u), static_cast<V>(v), w);
+        max_id = std::max({max_id, u, v});
+    }
+    b.n = static_cast<V>(max_id + 1);
+    return b;
+}
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef PATH_GRAPH_LOADER_H
+#define PATH_GRAPH_LOADER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph_file.h"
+#include "thread_pool.h"
+
+/**
+ * 多线程文本图加载器，支持 DIMACS 第 9 届挑战赛的 .gr / .co 文件以及逗号或空白分隔的边表 (CSV)。
+ *
+ * 文件先 mmap，再按行边界切成若干块由线程池并行解析，数字用 std::from_chars 解析，不经过 iostream；
+ * 各块的边最后用并行计数排序直接生成 CSR，结果可以直接交给 Dijkstra / BiDirDijkstra 的构造函数：
+ *
+ *   auto graph = load_text_graph<int>("USA-road-d.NY.gr");
+ *   BiDirDijkstra<int> d(std::move(graph.forward), std::move(graph.reverse));
+ *
+ * 格式错误时抛出 std::runtime_error，信息中带有行号。
+ */
+
+enum class TextFormat {
+    Dimacs,    // p sp <n> <m> / a <u> <v> <w>，节点编号从 1 开始，c 开头为注释
+    EdgeList,  // u v w 或 u,v,w，节点编号从 0 开始，# 开头为注释，第一行可以是表头
+};
+
+/**
+ * @brief 按扩展名猜测格式：.gr 为 DIMACS，其余为边表。
+ */
+inline TextFormat guess_text_format(const std::string &path) {
+    return path.size() >= 3 && path.compare(path.size() - 3, 3, ".gr") == 0 ? TextFormat::Dimacs
+                                                                             : TextFormat::EdgeList;
+}
+
+namespace text_detail {
+
+constexpr std::size_t MIN_CHUNK_BYTES = 1 << 16;  // 小于此大小的块不值得单独调度
+
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == ',' || c == '\r'; }
+
+inline const char *skip_blank(const char *p, const char *e) {
+    while (p < e && is_blank(*p)) ++p;
+    return p;
+}
+
+/**
+ * @brief 跳过分隔符后解析一个数，成功时 p 移到数字之后。
+ */
+template <typename X>
+bool parse(const char *&p, const char *e, X &out) {
+    p = skip_blank(p, e);
+    auto [q, ec] = std::from_chars(p, e, out);
+    if (ec != std::errc()) return false;
+    p = q;
+    return true;
+}
+
+/**
+ * @brief 把 [0, size) 切成最多 parts 块，每块都从行首开始，返回 parts + 1 个边界 (块可能为空)。
+ */
+inline std::vector<std::size_t> split_lines(const char *data, std::size_t size, std::size_t parts) {
+    std::vector<std::size_t> cut{0};
+    for (std::size_t i = 1; i < parts; ++i) {
+        std::size_t p = std::max(cut.back(), size / parts * i);
+        if (p > 0 && p < size) {  // 移到下一行的行首
+            auto nl = static_cast<const char *>(std::memchr(data + p - 1, '\n', size - p + 1));
+            p = nl ? nl - data + 1 : size;
+        }
+        cut.push_back(p);
+    }
+    cut.push_back(size);
+    return cut;
+}
+
+inline std::size_t line_number(const char *data, std::size_t pos) { return std::count(data, data + pos, '\n') + 1; }
+
+/**
+ * @brief 对 [begin, end) 中的每一行调用 f(行首, 行尾)，f 返回 false 时停止。
+ */
+template <typename F>
+void for_each_line(const char *data, std::size_t begin, std::size_t end, F &&f) {
+    const char *p = data + begin, *e = data + end;
+    while (p < e) {
+        auto nl = static_cast<const char *>(std::memchr(p, '\n', e - p));
+        const char *eol = nl ? nl : e;
+        if (!f(p, eol)) return;
+        p = eol + 1;
+    }
+}
+
+/**
+ * @brief 一块文本的解析结果。
+ */
+template <typename T, NodeId V>
+struct ParsedChunk {
+    CSRBuilder<T, V> edges;
+    long long max_node = -1;                // 出现过的最大节点编号，已换算为从 0 开始
+    long long nodes = -1;                   // DIMACS 问题行给出的节点数
+    std::size_t error = std::string::npos;  // 第一处格式错误所在行的字节位置
+};
+
+template <typename T, NodeId V>
+ParsedChunk<T, V> parse_edges(const char *data, std::size_t begin, std::size_t end, TextFormat format, bool first) {
+    ParsedChunk<T, V> out;
+    auto &b = out.edges;
+    const std::size_t guess = (end - begin) / 16;  // 按每行约 16 字节预留
+    b.src.reserve(guess), b.dst.reserve(guess), b.cost.reserve(guess);
+    bool header = first && format == TextFormat::EdgeList;  // 边表的第一个非注释行可以是表头
+
+    for_each_line(data, begin, end, [&](const char *line, const char *e) {
+        auto fail = [&] {
+            out.error = line - data;
+            return false;
+        };
+        const char *p = skip_blank(line, e);
+        if (p == e) return true;
+        long long u, v;
+        T w;
+        if (format == TextFormat::Dimacs) {
+            char kind = *p++;
+            if (kind == 'c') return true;
+            if (kind == 'p') {  // p sp <n> <m>
+                long long nodes, m;
+                p = skip_blank(p, e);
+                if (e - p < 2 || p[0] != 's' || p[1] != 'p') return fail();
+                p += 2;
+                if (!parse(p, e, nodes) || !parse(p, e, m) || nodes < 0 || std::uint64_t(nodes) >= no_node<V>()) return fail();
+                out.nodes = nodes;
+                return true;
+            }
+            if (kind != 'a' || !parse(p, e, u) || !parse(p, e, v) || !parse(p, e, w) || u < 1 || v < 1) return fail();
+            --u, --v;
+        } else {
+            if (*p == '#') return true;
+            if (!parse(p, e, u) || !parse(p, e, v) || !parse(p, e, w) || u < 0 || v < 0) {
+                if (!header) return fail();
+                header = false;
+                return true;
+            }
+        }
+        header = false;
+        if (!(w >= T(0))) return fail();  // 负边权 (以及 NaN) 会让 Dijkstra 给出错误结果
+        // 最大编号 + 1 为节点数，不能达到 no_node<V>()，与 read_edge_list 相同
+        if (std::uint64_t(u) + 1 >= no_node<V>() || std::uint64_t(v) + 1 >= no_node<V>()) return fail();
+        b.add(static_cast<V>(u), static_cast<V>(v), w);
+        out.max_node = std::max({out.max_node, u, v});
+        return true;
+    });
+    return out;
+}
+
+}  // namespace text_detail
+
+/**
+ * @brief 用并行计数排序把多块边合并成 n 个节点的 CSR 图。
+ *
+ * 结果与把各块依次 add 到同一个 CSRBuilder 再 build 完全相同 (每个节点的边保持输入顺序)：
+ * 先把节点划分为若干段，各块按段分散到临时数组，然后各段独立地按节点计数排序。
+ *
+ * @param reverse 为 true 时按目标节点分桶，生成反向图
+ */
+template <typename T, NodeId V>
+CSRGraph<T, V> parallel_build(const std::vector<CSRBuilder<T, V>> &parts, V n, bool reverse,
+                              ThreadPool &pool = default_thread_pool()) {
+    CSRGraph<T, V> g(n);
+    const std::size_t chunks = parts.size();
+    const std::size_t span = std::max<std::size_t>(1024, n / (std::size_t(pool.size()) * 16) + 1);  // 每段的节点数
+    const std::size_t blocks = (n + span - 1) / span;
+    auto key_of = [&](const CSRBuilder<T, V> &b) -> const std::vector<V> & { return reverse ? b.dst : b.src; };
+    auto val_of = [&](const CSRBuilder<T, V> &b) -> const std::vector<V> & { return reverse ? b.src : b.dst; };
+
+    // 每块在每段中的边数，按 (段, 块) 的顺序求前缀和后变为写入位置
+    std::vector<std::size_t> pos(chunks * blocks, 0), block_start(blocks + 1, 0);
+    pool.parallel_for(chunks, [&](std::size_t c, int) {
+        for (V k : key_of(parts[c])) ++pos[c * blocks + k / span];
+    });
+    std::size_t total = 0;
+    for (std::size_t s = 0; s < blocks; ++s) {
+        block_start[s] = total;
+        for (std::size_t c = 0; c < chunks; ++c) total += std::exchange(pos[c * blocks + s], total);
+    }
+    block_start[blocks] = total;
+
+    std::vector<V> key(total), val(total);
+    std::vector<T> cost(total);
+    pool.parallel_for(chunks, [&](std::size_t c, int) {
+        const auto &ks = key_of(parts[c]), &vs = val_of(parts[c]);
+        std::size_t *at = pos.data() + c * blocks;
+        for (std::size_t i = 0; i < ks.size(); ++i) {
+            auto p = at[ks[i] / span]++;
+            key[p] = ks[i], val[p] = vs[i], cost[p] = parts[c].cost[i];
+        }
+    });
+
+    g.targets.resize(total);
+    g.weights.resize(total);
+    std::size_t *offsets = g.offsets.owned.data();
+    V *targets = g.targets.owned.data();
+    T *weights = g.weights.owned.data();
+    pool.parallel_for(blocks, [&](std::size_t s, int) {
+        const V lo = static_cast<V>(s * span), hi = static_cast<V>(std::min<std::size_t>(n, lo + span));
+        for (auto p = block_start[s]; p < block_start[s + 1]; ++p) ++offsets[key[p] + 1];
+        // offsets[lo] 属于上一段，这里不读它，从 block_start 开始累加
+        std::vector<std::size_t> next(hi - lo);
+        std::size_t run = block_start[s];
+        for (V u = lo; u < hi; ++u) {
+            next[u - lo] = run;
+            offsets[u + 1] = run += offsets[u + 1];
+        }
+        for (auto p = block_start[s]; p < block_start[s + 1]; ++p) {
+            auto i = next[key[p] - lo]++;
+            targets[i] = val[p], weights[i] = cost[p];
+        }
+    });
+    return g;
+}
+
+/**
+ * @brief 并行加载文本图。返回结构与 map_csr_file 相同，但数组为自有内存。
+ *
+ * @param with_reverse 是否同时生成 BiDirDijkstra 需要的反向图
+ */
+template <typename T, NodeId V = std::uint32_t>
+MappedGraph<T, V> load_text_graph(const std::string &path, TextFormat format, bool with_reverse = true,
+                                  ThreadPool &pool = default_thread_pool()) {
+    MappedFile file(path);
+    const std::size_t parts =
+        std::clamp<std::size_t>(file.size / text_detail::MIN_CHUNK_BYTES, 1, std::size_t(pool.size()) * 4);
+    auto cut = text_detail::split_lines(file.data, file.size, parts);
+    std::vector<text_detail::ParsedChunk<T, V>> chunks(parts);
+    pool.parallel_for(parts, [&](std::size_t i, int) {
+        chunks[i] = text_detail::parse_edges<T, V>(file.data, cut[i], cut[i + 1], format, i == 0);
+    });
+
+    long long nodes = -1, max_node = -1;
+    for (const auto &c : chunks) {
+        if (c.error != std::string::npos)
+            throw std::runtime_error(path + ": line " + std::to_string(text_detail::line_number(file.data, c.error)) +
+                                     ": malformed");
+        if (nodes < 0) nodes = c.nodes;
+        max_node = std::max(max_node, c.max_node);
+    }
+    if (format == TextFormat::Dimacs) {
+        if (nodes < 0) throw std::runtime_error(path + ": no DIMACS problem line");
+        if (max_node >= nodes) throw std::runtime_error(path + ": arc endpoint exceeds node count");
+    } else {
+        nodes = max_node + 1;
+    }
+
+    std::vector<CSRBuilder<T, V>> edges;
+    edges.reserve(parts);
+    for (auto &c : chunks) edges.push_back(std::move(c.edges));
+
+    MappedGraph<T, V> out;
+    out.forward = parallel_build(edges, static_cast<V>(nodes), false, pool);
+    if (with_reverse) out.reverse = parallel_build(edges, static_cast<V>(nodes), true, pool), out.has_reverse = true;
+    return out;
+}
+
+template <typename T, NodeId V = std::uint32_t>
+MappedGraph<T, V> load_text_graph(const std::string &path, bool with_reverse = true,
+                                  ThreadPool &pool = default_thread_pool()) {
+    return load_text_graph<T, V>(path, guess_text_format(path), with_reverse, pool);
+}
+
+/**
+ * @brief 并行读取 DIMACS .co 坐标文件 (p aux sp co <n> / v <id> <x> <y>，编号从 1 开始)。
+ *
+ * @param max_nodes 问题行的节点数上限，通常为图的节点数；超过时抛出异常，编号超过节点数同样抛出异常
+ * @return 按节点编号排列的 (x, y)，文件中没有出现的节点为 (0, 0)
+ */
+template <NodeId V = std::uint32_t>
+std::vector<std::pair<double, double>> load_dimacs_coordinates(const std::string &path, V max_nodes = no_node<V>() - 1,
+                                                               ThreadPool &pool = default_thread_pool()) {
+    struct Chunk {
+        std::vector<std::pair<long long, std::pair<double, double>>> nodes;
+        long long count = -1, max_id = 0;
+        std::size_t error = std::string::npos;
+    };
+
+    MappedFile file(path);
+    const std::size_t parts =
+        std::clamp<std::size_t>(file.size / text_detail::MIN_CHUNK_BYTES, 1, std::size_t(pool.size()) * 4);
+    auto cut = text_detail::split_lines(file.data, file.size, parts);
+    std::vector<Chunk> chunks(parts);
+    pool.parallel_for(parts, [&](std::size_t i, int) {
+        auto &out = chunks[i];
+        text_detail::for_each_line(file.data, cut[i], cut[i + 1], [&](const char *line, const char *e) {
+            const char *p = text_detail::skip_blank(line, e);
+            if (p == e || *p == 'c') return true;
+            long long id;
+            double x, y;
+            if (*p == 'p') {  // 节点数是行中唯一的数字
+                while (p < e && (*p < '0' || *p > '9')) ++p;
+                if (text_detail::parse(p, e, out.count)) return true;
+            } else if (*p == 'v' && text_detail::parse(++p, e, id) && text_detail::parse(p, e, x) &&
+                       text_detail::parse(p, e, y) && id >= 1) {
+                out.nodes.push_back({id - 1, {x, y}});
+                out.max_id = std::max(out.max_id, id);
+                return true;
+            }
+            out.error = line - file.data;
+            return false;
+        });
+    });
+
+    long long n = -1, max_id = 0;
+    for (const auto &c : chunks) {
+        if (c.error != std::string::npos)
+            throw std::runtime_error(path + ": line " + std::to_string(text_detail::line_number(file.data, c.error)) +
+                                     ": malformed");
+        if (n < 0) n = c.count;
+        max_id = std::max(max_id, c.max_id);
+    }
+    if (n < 0) throw std::runtime_error(path + ": no DIMACS problem line");
+    if (std::uint64_t(n) > max_nodes) throw std::runtime_error(path + ": node count exceeds graph");
+    if (max_id > n) throw std::runtime_error(path + ": node id exceeds node count");
+    std::vector<std::pair<double, double>> coords(n);
+    for (const auto &c : chunks)
+        for (const auto &[id, xy] : c.nodes) coords[id] = xy;
+    return coords;
+}
+
+/**
+ * @brief 把文本图转换为带反向图的 CSR 文件，格式按扩展名判断。
+ *
+ * @return 转换得到的 (节点数, 边数)
+ */
+template <typename T, NodeId V = std::uint32_t>
+std::pair<V, std::size_t> convert_to_csr_file(const std::string &input, const std::string &output,
+                                              ThreadPool &pool = default_thread_pool()) {
+    auto g = load_text_graph<T, V>(input, true, pool);
+    write_csr_file(output, g.forward, &g.reverse);
+    return {g.forward.n, g.forward.edge_count()};
+}
+
+#endif
@@ -0,0 +1,428 @@
+#ifndef PATH_HUB_LABELS_H
+#define PATH_HUB_LABELS_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "contraction_hierarchy.h"
+#include "csr_graph.h"
+#include "graph_file.h"
+#include "priority_queue.h"
+#include "weight.h"
+#include "workspace.h"
+
+/**
+ * @brief 一个方向的全部标签，按节点以 CSR 形式存放，每个节点的标签按枢纽序号升序排列。
+ *
+ * hubs / dist / parent 分开存放 (SoA)，求交只需顺序扫描两段编号数组；每段末尾有一个序号为 n 的哨兵，
+ * 求交的循环不需要检查边界。
+ */
+template <typename T, NodeId V = std::uint32_t>
+struct HubLabelSet {
+    std::vector<std::size_t> offsets;  // 长度为 n + 1，节点 v 的标签为 [offsets[v], offsets[v + 1])，含哨兵
+    std::vector<V> hubs;               // 枢纽在 order 中的序号，越小越重要
+    std::vector<T> dist;               // 到枢纽 (出标签) 或从枢纽 (入标签) 的距离
+    std::vector<V> parent;             // 最短路径上朝枢纽方向的下一个节点，枢纽自身为 no_node<V>()
+
+    std::size_t entries() const { return hubs.size() - (offsets.empty() ? 0 : offsets.size() - 1); }
+
+    std::size_t memory_bytes() const {
+        return offsets.size() * sizeof(std::size_t) + hubs.size() * (sizeof(V) * 2 + sizeof(T));
+    }
+
+    /**
+     * @brief 在 v 的标签中二分查找序号为 hub 的枢纽，返回下标，找不到时返回 -1。
+     */
+    std::ptrdiff_t find(V v, V hub) const {
+        auto first = hubs.begin() + offsets[v], last = hubs.begin() + offsets[v + 1] - 1;
+        auto it = std::lower_bound(first, last, hub);
+        return it != last && *it == hub ? it - hubs.begin() : -1;
+    }
+};
+
+/**
+ * @brief 标签的规模，由 build 返回。
+ */
+struct HubLabelStats {
+    double avg_out = 0, avg_in = 0;  // 每个节点的平均出标签 / 入标签数 (不含哨兵)
+    std::size_t bytes = 0;           // 两个方向标签占用的总字节数
+    double bytes_per_node = 0;
+};
+
+/**
+ * @brief 枢纽标签 (Hub Labeling)：每个节点保存出标签 {(h, d(v, h))} 和入标签 {(h, d(h, v))}，
+ * d(s, t) 为 s 的出标签与 t 的入标签中公共枢纽上的最小距离和，查询只是一次有序数组的归并求交。
+ *
+ * 按收缩层次的收缩顺序从最重要的节点开始做剪枝 Dijkstra (pruned landmark labeling)：从枢纽 h 出发
+ * 确定节点 v 时，若已有的标签已经给出不超过当前距离的 s-t 距离，则 v 既不加标签也不再扩展。
+ * 被加入标签的节点在搜索树中的前驱也一定带有同一个枢纽，因此沿 parent 逐跳查找即可展开路径。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ * @tparam Q 构建时剪枝 Dijkstra 使用的优先队列策略，见 priority_queue.h
+ */
+template <Weight T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>>
+struct HubLabels {
+    using E = std::pair<T, V>;
+    using M = std::pair<T, std::vector<E>>;
+    using Workspace = SearchWorkspace<T, Q>;
+    static constexpr T INF = infinity<T>();
+    static constexpr V NONE = no_node<V>();
+
+    V n;
+    CSRGraph<T, V> g;           // 原图，read_hub_labels 读入的标签不带原图
+    CSRBuilder<T, V> pending;   // 尚未预处理的边
+    std::vector<V> order;       // order[i] 为序号为 i 的枢纽，order[0] 最重要
+    HubLabelSet<T, V> out, in;  // 出标签和入标签
+
+    HubLabels(V N) : n(N), g(N), pending(N) {}
+
+    /**
+     * @brief 直接使用收缩层次的图和收缩顺序构建，不会重复收缩。
+     */
+    explicit HubLabels(ContractionHierarchy<T, V, Q> &ch) : n(ch.n), pending(ch.n) {
+        ch.preprocess();
+        g = ch.g;
+        build(g, ch.rank);
+    }
+
+    bool check(V u) const { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return;
+        pending.add(u, v, cost);
+    }
+
+    bool built() const { return out.offsets.size() == static_cast<std::size_t>(n) + 1; }
+
+    /**
+     * @brief 用收缩层次求出节点顺序并构建标签。查询前会自动调用；之后再 add_edge 会触发重新构建。
+     */
+    void preprocess() {
+        if (pending.empty() && built()) return;
+        g = pending.build(&g);
+        pending.clear();
+        ContractionHierarchy<T, V, Q> ch(n);
+        ch.g = g;
+        ch.preprocess();
+        build(g, ch.rank);
+    }
+
+    /**
+     * @brief 按 rank (越大越重要，如 ContractionHierarchy::rank) 构建 graph 的标签。
+     */
+    HubLabelStats build(const CSRGraph<T, V> &graph, const std::vector<V> &rank) {
+        order.resize(n);
+        for (V v = 0; v < n; ++v) order[v] = v;
+        std::sort(order.begin(), order.end(), [&](V a, V b) { return rank[a] > rank[b]; });
+
+        // 反向图：reverse[v] 为所有 u -> v 的边
+        CSRBuilder<T, V> b(n);
+        b.src.reserve(graph.edge_count()), b.dst.reserve(graph.edge_count()), b.cost.reserve(graph.edge_count());
+        for (V u = 0; u < n; ++u)
+            for (const auto &[c, to] : graph[u]) b.add(u, to, c);
+        CSRGraph<T, V> reverse = b.build(nullptr, true);
+
+        struct Entry {
+            V hub;
+            T dist;
+            V parent;
+        };
+        std::vector<std::vector<Entry>> out_labels(n), in_labels(n);
+        std::vector<T> hub_dist(n);  // 当前枢纽自身标签中到各枢纽的距离，按枢纽序号索引
+        std::vector<char> has_hub(n, 0);
+        Workspace ws;
+
+        // 从 order[i] 出发的剪枝 Dijkstra：forward 为 true 时沿正向图生成入标签，否则沿反向图生成出标签
+        auto pruned_search = [&](V i, bool forward) {
+            const V h = order[i];
+            const CSRGraph<T, V> &adj = forward ? graph : reverse;
+            auto &own = forward ? out_labels[h] : in_labels[h];  // 与被确定节点的标签配对的一侧
+            auto &labels = forward ? in_labels : out_labels;
+            for (const auto &e : own) hub_dist[e.hub] = e.dist, has_hub[e.hub] = 1;
+
+            ws.reset(n);
+            ws.set(h, 0, {0, NONE});
+            ws.pq.push(0, h);
+            while (!ws.pq.empty()) {
+                auto [d, v] = ws.pq.top();
+                ws.pq.pop();
+                if (ws.dist[v] < d) continue;
+
+                bool covered = false;  // 已有标签给出的距离不超过 d
+                for (const auto &e : labels[v])
+                    if (has_hub[e.hub] && !(d < saturating_add(hub_dist[e.hub], e.dist))) {
+                        covered = true;
+                        break;
+                    }
+                if (covered) continue;
+
+                labels[v].push_back({i, d, ws.prev[v].second});
+                for (const auto &[c, to] : adj[v]) {
+                    T cand = saturating_add(d, c);
+                    if (cand < ws.get(to, INF)) {
+                        ws.set(to, cand, {c, v});
+                        ws.pq.push(cand, to);
+                    }
+                }
+            }
+            for (const auto &e : own) has_hub[e.hub] = 0;
+        };
+        for (V i = 0; i < n; ++i) {
+            pruned_search(i, true);
+            pruned_search(i, false);
+        }
+
+        auto flatten = [&](std::vector<std::vector<Entry>> &labels, HubLabelSet<T, V> &set) {
+            set.offsets.assign(std::size_t(n) + 1, 0);
+            for (V v = 0; v < n; ++v) set.offsets[v + 1] = set.offsets[v] + labels[v].size() + 1;
+            set.hubs.resize(set.offsets[n]);
+            set.dist.resize(set.offsets[n]);
+            set.parent.resize(set.offsets[n]);
+            for (V v = 0; v < n; ++v) {
+                auto p = set.offsets[v];
+                for (const auto &e : labels[v]) set.hubs[p] = e.hub, set.dist[p] = e.dist, set.parent[p++] = e.parent;
+                set.hubs[p] = n, set.dist[p] = T(0), set.parent[p] = NONE;  // 哨兵
+                labels[v] = {};
+            }
+        };
+        flatten(out_labels, out);
+        flatten(in_labels, in);
+        return stats();
+    }
+
+    HubLabelStats stats() const {
+        HubLabelStats st;
+        st.bytes = out.memory_bytes() + in.memory_bytes();
+        if (n > 0) {
+            st.avg_out = double(out.entries()) / n;
+            st.avg_in = double(in.entries()) / n;
+            st.bytes_per_node = double(st.bytes) / n;
+        }
+        return st;
+    }
+
+    /**
+     * @brief 出标签 s 与入标签 t 归并求交。
+     *
+     * @return (最短距离, 公共枢纽在 out / in 中的下标)，没有公共枢纽时距离为 INF
+     */
+    std::pair<T, std::pair<std::size_t, std::size_t>> intersect(V s, V t) const {
+        const std::size_t a0 = out.offsets[s], b0 = in.offsets[t];
+        const V *a = out.hubs.data() + a0, *b = in.hubs.data() + b0;
+        const T *da = out.dist.data() + a0, *db = in.dist.data() + b0;
+        T best = INF;
+        std::size_t bi = 0, bj = 0;
+        for (std::size_t i = 0, j = 0;;) {
+            V x = a[i], y = b[j];
+            if (x == y) {
+                if (x == n) break;  // 两侧同时到达哨兵
+                T d = saturating_add(da[i], db[j]);
+                if (d < best) best = d, bi = i, bj = j;
+            }
+            i += x <= y;  // 无分支地推进较小的一侧
+            j += y <= x;
+        }
+        return {best, {a0 + bi, b0 + bj}};
+    }
+
+    T shortest_dist(V s, V t) {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        preprocess();
+        return intersect(s, t).first;
+    }
+
+    /**
+     * @brief 求 s 到 t 的最短路径：沿两侧标签的 parent 逐跳走到公共枢纽，返回值与 BiDirDijkstra::shortest_path 相同。
+     */
+    M shortest_path(V s, V t) {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        preprocess();
+
+        auto [dist, at] = intersect(s, t);
+        if (dist == INF) return {INF, {}};  // 未找到路径
+        const V hub = out.hubs[at.first];
+
+        std::vector<E> path{{0, s}};
+        for (auto k = at.first; out.parent[k] != NONE;) {  // s -> 枢纽
+            V next = out.parent[k];
+            auto nk = out.find(next, hub);
+            path.emplace_back(out.dist[k] - out.dist[nk], next);
+            k = nk;
+        }
+        std::vector<E> tail;  // t -> 枢纽，反转后接在后面
+        V cur = t;
+        for (auto k = at.second; in.parent[k] != NONE;) {
+            V prev = in.parent[k];
+            auto pk = in.find(prev, hub);
+            tail.emplace_back(in.dist[k] - in.dist[pk], cur);
+            cur = prev, k = pk;
+        }
+        path.insert(path.end(), tail.rbegin(), tail.rend());
+        return {dist, path};
+    }
+};
+
+/**
+ * 枢纽标签文件，小端序：
+ *
+ *   HubLabelFileHeader  64 字节
+ *   order               n x uint32
+ *   出标签 offsets (n + 1) x uint64, hubs / parent 各 entries x uint32 (枢纽自身的 parent 为 0xffffffff), dist entries x weight_size
+ *   入标签，格式同上
+ *
+ * 节点编号固定为 32 位，只能读写 V 为 std::uint32_t 的标签。文件格式或读写失败时抛出 std::runtime_error。
+ */
+constexpr char HUB_LABEL_FILE_MAGIC[8] = {'S', 'P', 'H', 'U', 'B', 0, 0, 0};
+constexpr std::uint32_t HUB_LABEL_FILE_VERSION = 1;
+
+struct HubLabelFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t weight_kind;  // 同 CSRFileHeader
+    std::uint32_t weight_size;
+    std::uint32_t reserved0;
+    std::uint64_t n;
+    std::uint64_t out_entries;  // 出标签总条数，含哨兵
+    std::uint64_t in_entries;
+    std::uint64_t reserved[2];
+};
+static_assert(sizeof(HubLabelFileHeader) == 64);
+
+template <typename T, NodeId V, typename Q>
+void write_hub_labels(const std::string &path, HubLabels<T, V, Q> &hl) {
+    static_assert(std::is_arithmetic_v<T>, "hub label files only store arithmetic weights");
+    static_assert(std::is_same_v<V, std::uint32_t>, "hub label files store 32-bit node ids");
+    if constexpr (std::endian::native != std::endian::little)
+        throw std::runtime_error("hub label files can only be written on little-endian hosts");
+    hl.preprocess();
+
+    HubLabelFileHeader h{};
+    std::memcpy(h.magic, HUB_LABEL_FILE_MAGIC, sizeof(h.magic));
+    h.version = HUB_LABEL_FILE_VERSION;
+    h.weight_kind = csr_weight_kind<T>();
+    h.weight_size = sizeof(T);
+    h.n = hl.n;
+    h.out_entries = hl.out.hubs.size();
+    h.in_entries = hl.in.hubs.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("cannot open " + path + " for writing");
+    auto write = [&](const void *p, std::size_t bytes) { out.write(static_cast<const char *>(p), bytes); };
+    auto write_set = [&](const HubLabelSet<T, V> &set) {
+        std::vector<std::uint64_t> offsets(set.offsets.begin(), set.offsets.end());
+        write(offsets.data(), offsets.size() * 8);
+        write(set.hubs.data(), set.hubs.size() * 4);
+        write(set.parent.data(), set.parent.size() * 4);
+        write(set.dist.data(), set.dist.size() * sizeof(T));
+    };
+    write(&h, sizeof(h));
+    write(hl.order.data(), hl.order.size() * 4);
+    write_set(hl.out);
+    write_set(hl.in);
+    if (!out.flush()) throw std::runtime_error("failed to write " + path);
+}
+
+/**
+ * @brief 读入 write_hub_labels 写出的标签，并检查偏移、哨兵和节点编号。读入的标签只用于查询，不能再 add_edge。
+ */
+template <typename T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>>
+HubLabels<T, V, Q> read_hub_labels(const std::string &path) {
+    static_assert(std::is_arithmetic_v<T>, "hub label files only store arithmetic weights");
+    static_assert(std::is_same_v<V, std::uint32_t>, "hub label files store 32-bit node ids");
+    constexpr V NONE = no_node<V>();
+    if constexpr (std::endian::native != std::endian::little)
+        throw std::runtime_error("hub label files can only be read on little-endian hosts");
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    auto read = [&](void *p, std::size_t bytes) {
+        if (!in.read(static_cast<char *>(p), bytes)) throw std::runtime_error(path + ": truncated");
+    };
+
+    HubLabelFileHeader h;
+    read(&h, sizeof(h));
+    if (std::memcmp(h.magic, HUB_LABEL_FILE_MAGIC, sizeof(h.magic)) != 0)
+        throw std::runtime_error(path + ": not a hub label file");
+    if (h.version != HUB_LABEL_FILE_VERSION)
+        throw std::runtime_error(path + ": unsupported hub label file version " + std::to_string(h.version));
+    if (h.weight_kind != csr_weight_kind<T>() || h.weight_size != sizeof(T))
+        throw std::runtime_error(path + ": weight type does not match");
+    if (h.n >= NONE) throw std::runtime_error(path + ": too many nodes");  // 序号 n 用作哨兵
+
+    // 分配数组之前先用文件大小核对节点数和标签条数，损坏的头部不会引起巨大的分配
+    in.seekg(0, std::ios::end);
+    const std::uint64_t size = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(sizeof(h));
+    const std::uint64_t fixed = sizeof(h) + h.n * 4 + (h.n + 1) * 8 * 2;  // n < 2^32，不会溢出
+    const std::uint64_t per_entry = 4 + 4 + sizeof(T);
+    if (size < fixed || (size - fixed) % per_entry != 0 || h.out_entries > (size - fixed) / per_entry ||
+        h.in_entries != (size - fixed) / per_entry - h.out_entries)
+        throw std::runtime_error(path + ": size does not match header");
+
+    const V n = static_cast<V>(h.n);
+    HubLabels<T, V, Q> hl(n);
+    hl.order.resize(n);
+    read(hl.order.data(), std::size_t(n) * 4);
+    bool ok = std::all_of(hl.order.begin(), hl.order.end(), [&](V v) { return v < n; });
+
+    auto read_set = [&](HubLabelSet<T, V> &set, std::uint64_t entries) {
+        std::vector<std::uint64_t> offsets(h.n + 1);
+        read(offsets.data(), offsets.size() * 8);
+        set.offsets.assign(offsets.begin(), offsets.end());
+        set.hubs.resize(entries), set.parent.resize(entries), set.dist.resize(entries);
+        read(set.hubs.data(), entries * 4);
+        read(set.parent.data(), entries * 4);
+        read(set.dist.data(), entries * sizeof(T));
+
+        ok = ok && offsets[0] == 0 && offsets[h.n] == entries;
+        for (std::uint64_t v = 0; ok && v < h.n; ++v) {
+            ok = offsets[v] < offsets[v + 1] && offsets[v + 1] <= entries && set.hubs[offsets[v + 1] - 1] == n;  // 每段以哨兵结尾
+            for (auto i = offsets[v]; ok && i + 1 < offsets[v + 1]; ++i)
+                ok = set.hubs[i] < set.hubs[i + 1] && (set.parent[i] == NONE || set.parent[i] < n);
+        }
+        // 展开路径时沿 parent 查找同一个枢纽：枢纽自身没有 parent，其余节点的 parent 必须带有该枢纽且距离不更远
+        for (V v = 0; ok && v < n; ++v)
+            for (auto i = set.offsets[v]; ok && i + 1 < set.offsets[v + 1]; ++i) {
+                const V hub = set.hubs[i], par = set.parent[i];
+                if (par == NONE) {
+                    ok = hl.order[hub] == v;
+                } else {
+                    auto k = set.find(par, hub);
+                    ok = hl.order[hub] != v && k != -1 && !(set.dist[i] < set.dist[k]);
+                }
+            }
+        // 零权边使 parent 的距离可以与自身相等，距离检查排除不了环，因此沿每条 parent 链走到枢纽，每个条目只走一次
+        std::vector<char> state(ok ? entries : 0, 0);  // 0 未访问，1 在当前链上，2 已确认能走到枢纽
+        std::vector<std::size_t> chain;
+        for (V v = 0; ok && v < n; ++v)
+            for (auto i = set.offsets[v]; ok && i + 1 < set.offsets[v + 1]; ++i) {
+                std::size_t j = i;
+                chain.clear();
+                while (state[j] == 0 && set.parent[j] != NONE) {
+                    state[j] = 1;
+                    chain.push_back(j);
+                    j = set.find(set.parent[j], set.hubs[i]);
+                }
+                ok = state[j] != 1;
+                for (auto c : chain) state[c] = 2;
+                state[j] = 2;
+            }
+    };
+    read_set(hl.out, h.out_entries);
+    read_set(hl.in, h.in_entries);
+    if (!ok) throw std::runtime_error(path + ": corrupt hub label data");
+    return hl;
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef PATH_MULTI_SOURCE_H
+#define PATH_MULTI_SOURCE_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PATH_MULTI_SOURCE_AVX2 1
+#endif
+
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "thread_pool.h"
+#include "weight.h"
+
+/**
+ * 多源批量最短路的车道 (lane) 内核。每个节点的 K 个距离连续存放 (K x T 的 SoA 布局)，
+ * relax(from, c, to) 用一次向量加法和一次向量取最小值松弛一条边的全部 K 个车道，
+ * 有车道被改进时返回 true，并在 key 中给出被改进车道的最小新距离。
+ * 未到达的车道为 infinity<T>()，加法饱和到 infinity，因此未到达的车道和溢出的路径都不会改进任何车道。
+ */
+namespace multi_source_detail {
+
+template <typename T, int K>
+struct ScalarLanes {
+    static bool relax(const T *from, T c, T *to, T &key) {
+        bool improved = false;
+        key = infinity<T>();
+        for (int k = 0; k < K; ++k) {
+            T cand = saturating_add(from[k], c);
+            if (cand < to[k]) to[k] = cand, key = std::min(key, cand), improved = true;
+        }
+        return improved;
+    }
+};
+
+#ifdef PATH_MULTI_SOURCE_AVX2
+template <typename T>
+constexpr bool has_avx2_lanes = std::is_same_v<T, std::int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/**
+ * @brief 从 mask 中被置位的车道取最小的 to[k]，只在松弛成功时调用。
+ */
+template <typename T>
+inline T masked_min(const T *to, unsigned mask) {
+    T key = infinity<T>();
+    for (; mask; mask &= mask - 1) key = std::min(key, to[std::countr_zero(mask)]);
+    return key;
+}
+
+template <typename T, int K>
+struct Avx2Lanes {
+    static_assert(has_avx2_lanes<T>);
+    static constexpr int W = 32 / sizeof(T);  // 每个 256 位向量的车道数
+    static_assert(K % W == 0, "K must be a multiple of the AVX2 vector width");
+
+    __attribute__((target("avx2"))) static bool relax(const T *from, T c, T *to, T &key) {
+        unsigned mask = 0;
+        for (int i = 0; i < K; i += W) {
+            unsigned m;
+            if constexpr (std::is_same_v<T, std::int32_t>) {
+                // 两个非负 int32 之和按无符号数不会回绕，按无符号取 min 即饱和到 INT32_MAX
+                auto cand = _mm256_min_epu32(
+                    _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i)), _mm256_set1_epi32(c)),
+                    _mm256_set1_epi32(infinity<T>()));
+                auto old = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(to + i));
+                m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(old, cand)));
+                if (m) _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_min_epi32(old, cand));
+            } else if constexpr (std::is_same_v<T, float>) {
+                auto cand = _mm256_add_ps(_mm256_loadu_ps(from + i), _mm256_set1_ps(c));
+                auto old = _mm256_loadu_ps(to + i);
+                m = _mm256_movemask_ps(_mm256_cmp_ps(old, cand, _CMP_GT_OQ));
+                if (m) _mm256_storeu_ps(to + i, _mm256_min_ps(old, cand));
+            } else {
+                auto cand = _mm256_add_pd(_mm256_loadu_pd(from + i), _mm256_set1_pd(c));
+                auto old = _mm256_loadu_pd(to + i);
+                m = _mm256_movemask_pd(_mm256_cmp_pd(old, cand, _CMP_GT_OQ));
+                if (m) _mm256_storeu_pd(to + i, _mm256_min_pd(old, cand));
+            }
+            mask |= m << i;
+        }
+        if (!mask) return false;
+        key = masked_min(to, mask);
+        return true;
+    }
+};
+#endif
+
+}  // namespace multi_source_detail
+
+/**
+ * @brief 多源批量 Dijkstra：K 个起点共用一次遍历，每条边的 K 个车道用一次向量加法和取最小值松弛。
+ *
+ * 调度为分桶的标号修正 (label-correcting)：节点的键为自上次扫描以来被改进车道的最小距离按 delta 取整，
+ * 出队时松弛全部车道。各起点的波前到达同一节点的时间不同，分桶使落在同一个桶内的多次改进合并为一次扫描。
+ * 键不会小于最近一次出队的键，因此可以使用基数堆等单调队列。
+ * 支持 AVX2 时 (运行时检测) 对 int32 / float / double 边权使用 AVX2 内核，否则使用标量内核。
+ * 只计算距离，结果与对每个起点分别调用 Dijkstra::dijkstra(s).dist 逐位相同；
+ * 车道以 INF (即 infinity<T>()) 表示未到达，松弛做饱和加法，超出类型范围的路径与 Dijkstra 一样视为不可达。
+ *
+ * @tparam T 边权类型
+ * @tparam K 每批的起点数 (车道数)，一般取 8 或 16
+ * @tparam V 节点编号类型，见 NodeId
+ * @tparam Q 优先队列策略，见 priority_queue.h
+ */
+template <Weight T, int K = 8, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>>
+struct MultiSourceDijkstra {
+    static constexpr T INF = infinity<T>();
+    static_assert(K > 0 && K <= 32, "K lanes must fit in a 32-bit mask");
+    static_assert(std::is_same_v<typename Q::node_type, V>, "queue node type must match V");
+
+    V n;
+    T delta;               // 桶宽，<= 0 时在 finalize 时取平均边权
+    bool use_simd = true;  // 为 false 时强制使用标量内核
+    CSRGraph<T, V> g;
+    CSRBuilder<T, V> pending;
+
+    MultiSourceDijkstra(V N, T D = 0) : n(N), delta(D), g(N), pending(N) {}
+    explicit MultiSourceDijkstra(CSRGraph<T, V> graph, T D = 0) : n(graph.n), delta(D), g(std::move(graph)), pending(n) {}
+
+    bool check(V u) { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return;
+        pending.add(u, v, cost);
+    }
+
+    void add_bidir_edge(V u, V v, T cost) {
+        add_edge(u, v, cost);
+        add_edge(v, u, cost);
+    }
+
+    void finalize() {
+        if (!pending.empty()) {
+            g = pending.build(&g);
+            pending.clear();
+        }
+        if (!(T(0) < delta)) {
+            long double sum = 0;  // 与 DeltaStepping 相同，以宽类型累加，边权之和超出 T 的范围时不会截断
+            for (T c : g.weights) sum += c;
+            delta = g.weights.empty() ? T(1) : std::max<T>(T(1), T(sum / g.weights.size()));
+        }
+    }
+
+    /**
+     * @brief 当前平台和边权类型能否使用 AVX2 内核。
+     */
+    static bool simd_available() {
+#ifdef PATH_MULTI_SOURCE_AVX2
+        if constexpr (multi_source_detail::has_avx2_lanes<T> && K % (32 / sizeof(T)) == 0)
+            return __builtin_cpu_supports("avx2");
+#endif
+        return false;
+    }
+
+    /**
+     * @brief 每个工作线程复用的批量搜索状态。
+     */
+    struct Workspace {
+        std::vector<T> dist;              // dist[v * K + k] 为第 k 个起点到 v 的距离
+        std::vector<T> key;               // 节点入队时的键 (桶号)
+        std::vector<unsigned char> queued;  // 节点是否在队列中 (且 key 有效)
+        Q pq;
+    };
+
+    /**
+     * @brief 计算从每个起点出发到所有节点的最短距离，第 i 项对应 sources[i]，不可达为 INF，越界的起点得到空数组。
+     *
+     * 起点按 K 个一批，各批由线程池并行计算。
+     */
+    std::vector<std::vector<T>> distances(const std::vector<V> &sources, ThreadPool &pool) {
+        finalize();
+        std::vector<std::vector<T>> out(sources.size());
+        const std::size_t batches = (sources.size() + K - 1) / K;
+        std::vector<Workspace> workspaces(pool.size());
+        const bool simd = use_simd && simd_available();
+        pool.parallel_for(batches, [&](std::size_t b, int worker) {
+            const std::size_t first = b * K, count = std::min<std::size_t>(K, sources.size() - first);
+            auto &ws = workspaces[worker];
+            run_batch(sources.data() + first, count, ws, simd);
+            for (std::size_t k = 0; k < count; ++k) {
+                if (!check(sources[first + k])) continue;
+                auto &d = out[first + k];
+                d.resize(n);
+                for (V v = 0; v < n; ++v) d[v] = ws.dist[std::size_t(v) * K + k];
+            }
+        });
+        return out;
+    }
+
+    std::vector<std::vector<T>> distances(const std::vector<V> &sources) {
+        return distances(sources, default_thread_pool());
+    }
+
+    /**
+     * @brief 以 count (<= K) 个起点运行一批，结果留在 ws.dist 中；越界的起点对应的车道保持未到达。
+     */
+    void run_batch(const V *sources, std::size_t count, Workspace &ws, bool simd) {
+#ifdef PATH_MULTI_SOURCE_AVX2
+        if constexpr (multi_source_detail::has_avx2_lanes<T> && K % (32 / sizeof(T)) == 0)
+            if (simd) return run_avx2(sources, count, ws);
+#endif
+        (void)simd;
+        search<multi_source_detail::ScalarLanes<T, K>>(sources, count, ws);
+    }
+
+#ifdef PATH_MULTI_SOURCE_AVX2
+    // flatten 把 search 和 AVX2 内核整体内联到这个以 AVX2 编译的函数中
+    __attribute__((target("avx2"), flatten)) void run_avx2(const V *sources, std::size_t count, Workspace &ws) {
+        if constexpr (multi_source_detail::has_avx2_lanes<T> && K % (32 / sizeof(T)) == 0)
+            search<multi_source_detail::Avx2Lanes<T, K>>(sources, count, ws);
+    }
+#endif
+
+    template <typename Lanes>
+    void search(const V *sources, std::size_t count, Workspace &ws) {
+        ws.dist.assign(std::size_t(n) * K, INF);
+        ws.key.assign(n, INF);
+        ws.queued.assign(n, 0);
+        ws.pq.clear();
+
+        auto enqueue = [&](V v, T dist) {
+            T key = std::is_floating_point_v<T> ? std::floor(dist / delta) : dist / delta;
+            if (ws.queued[v] && !(key < ws.key[v])) return;
+            ws.queued[v] = 1, ws.key[v] = key;
+            ws.pq.push(key, v);
+        };
+        for (std::size_t k = 0; k < count; ++k) {
+            V s = sources[k];
+            if (!check(s)) continue;
+            ws.dist[std::size_t(s) * K + k] = T(0);
+            enqueue(s, T(0));
+        }
+
+        while (!ws.pq.empty()) {
+            auto [key, u] = ws.pq.top();
+            ws.pq.pop();
+            if (!ws.queued[u] || ws.key[u] < key) continue;  // 过期或已扫描
+            ws.queued[u] = 0;
+            const T *from = ws.dist.data() + std::size_t(u) * K;
+            for (const auto &[c, to] : g[u]) {
+                T improved;
+                if (Lanes::relax(from, c, ws.dist.data() + std::size_t(to) * K, improved)) enqueue(to, improved);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,440 @@
+#ifndef PATH_MULTILEVEL_OVERLAY_H
+#define PATH_MULTILEVEL_OVERLAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "reorder.h"
+#include "thread_pool.h"
+#include "weight.h"
+#include "workspace.h"
+
+/**
+ * @brief BFS 生长的划分：按整张图的 BFS 顺序依次取未分配的节点为种子，从种子 BFS 扩展，
+ * 直到单元内节点的 weight 之和达到 limit。adj 必须是无向的邻接表。
+ *
+ * @return 单元数，part[v] 为节点 v 的单元编号
+ */
+template <typename W, NodeId V>
+V grow_partition(const CSRGraph<W, V> &adj, const std::vector<V> &weight, long long limit, std::vector<V> &part) {
+    constexpr V NONE = no_node<V>();
+    const V n = adj.n;
+    std::vector<V> seeds;  // 种子顺序，使新单元紧挨着已有的单元
+    seeds.reserve(n);
+    std::vector<char> seen(n, 0);
+    for (V root = 0; root < n; ++root) {
+        if (seen[root]) continue;
+        seen[root] = 1, seeds.push_back(root);
+        for (std::size_t head = seeds.size() - 1; head < seeds.size(); ++head)
+            for (const auto &[c, to] : adj[seeds[head]])
+                if (!seen[to]) seen[to] = 1, seeds.push_back(to);
+    }
+
+    part.assign(n, NONE);
+    V cells = 0;
+    std::vector<V> queue;
+    for (V seed : seeds) {
+        if (part[seed] != NONE) continue;
+        const V cell = cells++;
+        long long size = weight[seed];
+        part[seed] = cell;
+        queue.assign(1, seed);
+        for (std::size_t head = 0; head < queue.size(); ++head)
+            for (const auto &[c, to] : adj[queue[head]])
+                if (part[to] == NONE && size + weight[to] <= limit) part[to] = cell, size += weight[to], queue.push_back(to);
+    }
+    return cells;
+}
+
+/**
+ * @brief 多层划分覆盖图 (Customizable Route Planning)。
+ *
+ * 预处理分为与边权无关的划分和依赖边权的定制两步：
+ *   划分   grow_partition 自下而上逐层合并出嵌套的单元，每层单元的节点数不超过 cell_limits 中对应的值；
+ *          与其他单元相连的节点为该层的边界节点。
+ *   定制   对每层每个单元，从每个边界节点出发在单元内搜索 (最细层用原图的边，其余层用下一层的 clique 和切边)，
+ *          得到边界节点之间的距离矩阵 (clique)。同一层的单元由线程池并行定制。
+ * 边权变化而拓扑不变时只需要 update_weights / set_weight 后重新定制，划分保持不变。
+ *
+ * add_edge / set_weight / update_weights 不能与查询并发。修改后第一次查询 (或显式调用 preprocess) 在 preprocessing
+ * 锁内重新定制，同时到达的其他查询等待定制完成，不会读到正在改写的距离矩阵；已定制时查询只读一次 dirty，不加锁。
+ *
+ * 查询在与 s、t 都不在同一单元的最高一层上使用 clique 和切边，在 s、t 所在的最细单元内使用原图的边，
+ * 正反两个方向在这个查询相关的图上做双向 Dijkstra，路径中的 clique 边在单元内重新搜索展开。
+ *
+ * 不可达的距离为 INF (即 infinity<T>())，路径起点的前驱为 NONE。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ * @tparam Q 优先队列策略，见 priority_queue.h
+ */
+template <Weight T, NodeId V = std::uint32_t, typename Q = DefaultQueue<T, V>>
+struct MultilevelOverlay {
+    static_assert(std::is_same_v<typename Q::node_type, V>, "queue node type must match V");
+    using E = std::pair<T, V>;
+    using M = std::pair<T, std::vector<E>>;
+    using Workspace = SearchWorkspace<T, Q>;
+    static constexpr T INF = infinity<T>();
+    static constexpr V NONE = no_node<V>();
+
+    /**
+     * @brief 一层划分：单元编号、各单元的边界节点和边界节点之间的距离矩阵。
+     */
+    struct Level {
+        std::vector<V> cell;  // 节点 -> 本层单元
+        V cells = 0;
+        std::vector<std::size_t> boundary_offsets;  // 单元 c 的边界节点为 boundary[boundary_offsets[c] .. boundary_offsets[c + 1])
+        std::vector<V> boundary;
+        std::vector<V> boundary_index;            // 节点在所在单元边界节点中的下标，非边界节点为 NONE
+        std::vector<std::size_t> matrix_offsets;  // 单元 c 的 k x k 矩阵起点，行为起点、列为终点
+        std::vector<T> matrix;                    // 单元内的最短距离，不可达为 infinity<T>()
+
+        V size(V c) const { return static_cast<V>(boundary_offsets[c + 1] - boundary_offsets[c]); }
+        T at(V c, V i, V j) const { return matrix[matrix_offsets[c] + std::size_t(i) * size(c) + j]; }
+    };
+
+    V n;
+    CSRGraph<T, V> g, gr;                  // 正向图和反向图
+    std::vector<std::size_t> reverse_pos;  // g 的第 i 条边在 gr 中的位置
+    CSRBuilder<T, V> pending;              // 尚未冻结的边
+    std::vector<int> cell_limits;          // 自下而上每层单元的最大节点数
+    std::vector<Level> levels;             // levels[0] 最细
+    bool partitioned = false;
+    std::atomic<bool> dirty{true};  // 加边或边权变化后尚未重新定制
+    std::mutex preprocessing;       // 串行化查询路径上的预处理
+
+    MultilevelOverlay(V N, std::vector<int> limits = {128, 2048, 32768})
+        : n(N), g(N), gr(N), pending(N), cell_limits(std::move(limits)) {}
+
+    bool check(V u) const { return u < n; }
+
+    void add_edge(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return;
+        pending.add(u, v, cost);
+        dirty = true;
+    }
+
+    /**
+     * @brief 冻结新加入的边并重新划分，边权变化后重新定制。查询前如果 dirty 会自动调用，并发调用时只有一个线程执行。
+     */
+    void preprocess(ThreadPool &pool) {
+        std::lock_guard<std::mutex> lock(preprocessing);
+        if (!pending.empty() || !partitioned) {
+            g = pending.build(&g);
+            pending.clear();
+            gr = reverse_graph(g, &reverse_pos);
+            partition();
+            partitioned = true;
+            dirty = true;
+        }
+        if (dirty.load(std::memory_order_relaxed)) customize(pool);
+    }
+
+    void preprocess() { preprocess(default_thread_pool()); }
+
+    /**
+     * @brief 查询前调用：已定制时只做一次 acquire 读取，否则加锁预处理。
+     */
+    void prepare() {
+        if (dirty.load(std::memory_order_acquire)) preprocess();
+    }
+
+    /**
+     * @brief 按 g 的边顺序整体替换边权 (拓扑不变)，然后并行重新定制。
+     */
+    void update_weights(const std::vector<T> &weights, ThreadPool &pool) {
+        preprocess(pool);
+        if (weights.size() != g.edge_count()) throw std::invalid_argument("weight count does not match the graph");
+        for (std::size_t i = 0; i < weights.size(); ++i) g.weights[i] = weights[i], gr.weights[reverse_pos[i]] = weights[i];
+        dirty = true;
+        customize(pool);
+    }
+
+    void update_weights(const std::vector<T> &weights) { update_weights(weights, default_thread_pool()); }
+
+    /**
+     * @brief 修改所有 u -> v 边的边权，下一次查询前重新定制。
+     *
+     * @return 是否存在这样的边
+     */
+    bool set_weight(V u, V v, T cost) {
+        if (!check(u) || !check(v)) return false;
+        preprocess();
+        bool found = false;
+        for (std::size_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+            if (g.targets[i] == v) g.weights[i] = cost, gr.weights[reverse_pos[i]] = cost, found = true;
+        if (found) dirty = true;
+        return found;
+    }
+
+    /**
+     * @brief 与边权无关的多层划分，并求出每层的边界节点。
+     */
+    void partition() {
+        levels.clear();
+        auto adj = reorder_detail::undirected(g);
+        std::vector<V> part;
+        const long long limit = cell_limits.empty() ? static_cast<long long>(n) : cell_limits[0];
+        V cells = grow_partition(adj, std::vector<V>(n, 1), limit, part);
+        for (std::size_t l = 0; l < cell_limits.size() && cells > 1; ++l) {
+            if (l > 0) {  // 在上一层单元的商图上继续合并
+                const auto &prev = levels.back();
+                CSRBuilder<int, V> qb(prev.cells);
+                for (V u = 0; u < n; ++u)
+                    for (const auto &[c, v] : adj[u])
+                        if (prev.cell[u] != prev.cell[v]) qb.add(prev.cell[u], prev.cell[v], 0);
+                std::vector<V> size(prev.cells, 0);
+                for (V v = 0; v < n; ++v) ++size[prev.cell[v]];
+                V merged = grow_partition(qb.build(), size, cell_limits[l], part);
+                if (merged == prev.cells) break;  // 无法继续合并
+                std::vector<V> cell(n);
+                for (V v = 0; v < n; ++v) cell[v] = part[prev.cell[v]];
+                part = std::move(cell);
+                cells = merged;
+                if (cells == 1) break;  // 只有一个单元的层没有边界节点
+            }
+            Level level;
+            level.cell = part;
+            level.cells = cells;
+            levels.push_back(std::move(level));
+        }
+        for (auto &level : levels) find_boundary(level);
+    }
+
+    void find_boundary(Level &level) {
+        level.boundary_index.assign(n, NONE);
+        level.boundary_offsets.assign(level.cells + 1, 0);
+        level.boundary.clear();
+        std::vector<V> nodes;
+        for (V v = 0; v < n; ++v) {
+            bool cut = false;
+            for (const auto &[c, to] : g[v]) cut = cut || level.cell[to] != level.cell[v];
+            for (const auto &[c, to] : gr[v]) cut = cut || level.cell[to] != level.cell[v];
+            if (cut) nodes.push_back(v), ++level.boundary_offsets[level.cell[v] + 1];
+        }
+        for (V c = 0; c < level.cells; ++c) level.boundary_offsets[c + 1] += level.boundary_offsets[c];
+        level.boundary.resize(nodes.size());
+        std::vector<std::size_t> pos(level.boundary_offsets.begin(), level.boundary_offsets.end() - 1);
+        for (V v : nodes) {  // 按节点编号升序
+            V c = level.cell[v];
+            level.boundary_index[v] = static_cast<V>(pos[c] - level.boundary_offsets[c]);
+            level.boundary[pos[c]++] = v;
+        }
+        level.matrix_offsets.assign(level.cells + 1, 0);
+        for (V c = 0; c < level.cells; ++c)
+            level.matrix_offsets[c + 1] = level.matrix_offsets[c] + std::size_t(level.size(c)) * level.size(c);
+        level.matrix.assign(level.matrix_offsets[level.cells], INF);
+    }
+
+    /**
+     * @brief 自下而上重新计算所有单元的距离矩阵，同一层的单元由线程池并行计算。
+     */
+    void customize(ThreadPool &pool) {
+        std::vector<Workspace> ws(pool.size());
+        for (std::size_t l = 0; l < levels.size(); ++l)
+            pool.parallel_for(levels[l].cells, [&](std::size_t c, int worker) {
+                customize_cell(l, static_cast<V>(c), ws[worker]);
+            });
+        dirty.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief 第 l 层单元 c 内从节点 u 出发的边：最细层为原图中不离开单元的边，
+     * 其余层为 u 在下一层单元中的 clique 边，以及离开下一层单元但仍在 c 内的原图的边。
+     */
+    template <typename F>
+    void for_each_cell_arc(std::size_t l, V c, V u, F &&f) const {
+        const auto &cell = levels[l].cell;
+        if (l == 0) {
+            for (const auto &[cost, to] : g[u])
+                if (cell[to] == c) f(cost, to);
+            return;
+        }
+        const auto &sub = levels[l - 1];
+        const V cu = sub.cell[u], iu = sub.boundary_index[u], k = sub.size(cu);
+        for (V j = 0; j < k; ++j)
+            if (T d = sub.at(cu, iu, j); j != iu && d != INF)
+                f(d, sub.boundary[sub.boundary_offsets[cu] + j]);
+        for (const auto &[cost, to] : g[u])
+            if (sub.cell[to] != cu && cell[to] == c) f(cost, to);
+    }
+
+    void customize_cell(std::size_t l, V c, Workspace &ws) {
+        auto &level = levels[l];
+        const V k = level.size(c);
+        const V *bnd = level.boundary.data() + level.boundary_offsets[c];
+        for (V i = 0; i < k; ++i) {
+            ws.reset(n);
+            ws.set(bnd[i], 0);
+            ws.pq.push(0, bnd[i]);
+            while (!ws.pq.empty()) {
+                auto [d, u] = ws.pq.top();
+                ws.pq.pop();
+                if (ws.dist[u] < d) continue;
+                for_each_cell_arc(l, c, u, [&](T cost, V to) {
+                    T cand = saturating_add(d, cost);
+                    if (cand < ws.get(to, INF)) {
+                        ws.set(to, cand);
+                        ws.pq.push(cand, to);
+                    }
+                });
+            }
+            T *row = level.matrix.data() + level.matrix_offsets[c] + std::size_t(i) * k;
+            for (V j = 0; j < k; ++j) row[j] = ws.get(bnd[j], INF);
+        }
+    }
+
+    /**
+     * @brief 节点 v 在 (s, t) 查询中使用的层：与 s、t 都不在同一单元的最高层 (1 起)，都在同一最细单元时为 0。
+     */
+    int query_level(V v, V s, V t) const {
+        for (int l = static_cast<int>(levels.size()); l >= 1; --l) {
+            const auto &cell = levels[l - 1].cell;
+            if (cell[v] != cell[s] && cell[v] != cell[t]) return l;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 查询图中节点 u 的出边 (backward 为 true 时为入边)：第 0 层为原图的边，
+     * 第 lvl 层为 u 所在单元的 clique 边和离开该单元的原图的边。
+     */
+    template <typename F>
+    void for_each_query_arc(V u, int lvl, bool backward, F &&f) const {
+        const CSRGraph<T, V> &graph = backward ? gr : g;
+        if (lvl == 0) {
+            for (const auto &[cost, to] : graph[u]) f(cost, to);
+            return;
+        }
+        const auto &level = levels[lvl - 1];
+        const V cu = level.cell[u], iu = level.boundary_index[u], k = level.size(cu);
+        for (V j = 0; j < k; ++j) {
+            T d = backward ? level.at(cu, j, iu) : level.at(cu, iu, j);
+            if (j != iu && d != INF) f(d, level.boundary[level.boundary_offsets[cu] + j]);
+        }
+        for (const auto &[cost, to] : graph[u])
+            if (level.cell[to] != cu) f(cost, to);
+    }
+
+    /**
+     * @brief 查询图上的双向 Dijkstra，停止条件与 BiDirDijkstra 相同。
+     *
+     * @return 最短距离，不可达为 INF；from / to / cost 为最佳路径经过的相遇边
+     */
+    T search(V s, V t, Workspace &fw, Workspace &bw, V &from, V &to, T &cost) {
+        Workspace *ws[2] = {&fw, &bw};
+        fw.reset(n), bw.reset(n);
+        fw.set(s, 0, {0, NONE}), bw.set(t, 0, {0, NONE});
+        fw.pq.push(0, s);
+        bw.pq.push(0, t);
+
+        T estimate = INF, top[2] = {INF, INF};
+        while (!fw.pq.empty() && !bw.pq.empty()) {
+            for (int dir = 0; dir < 2; ++dir) {
+                auto &self = *ws[dir];
+                auto &other = *ws[dir ^ 1];
+                if (self.pq.empty()) break;
+                auto [d, u] = self.pq.top();
+                self.pq.pop();
+                if (self.dist[u] < d) continue;
+                ++self.settled;
+                top[dir] = d;
+                for_each_query_arc(u, query_level(u, s, t), dir == 1, [&](T c, V v) {
+                    T cand = saturating_add(d, c);
+                    if (!(cand < self.get(v, INF))) return;
+                    self.set(v, cand, {c, u});
+                    self.pq.push(cand, v);
+                    if (!other.reached(v)) return;
+                    if (T through = saturating_add(cand, other.dist[v]); through < estimate) {
+                        estimate = through;
+                        from = dir == 0 ? u : v, to = dir == 0 ? v : u, cost = c;
+                    }
+                });
+            }
+            if (top[0] != INF && top[1] != INF && saturating_add(top[0], top[1]) >= estimate) break;
+        }
+        return estimate;
+    }
+
+    T shortest_dist(V s, V t, Workspace &fw, Workspace &bw) {
+        if (!check(s) || !check(t)) return INF;  // 检查越界
+        if (s == t) return T(0);                 // 起点和终点相同
+        prepare();
+        V from, to;
+        T cost;
+        return search(s, t, fw, bw, from, to, cost);
+    }
+
+    T shortest_dist(V s, V t) { return shortest_dist(s, t, thread_workspace<T, Q, 0>(), thread_workspace<T, Q, 1>()); }
+
+    /**
+     * @brief 求 s 到 t 的最短路径，clique 边在所在单元内重新搜索，展开为原图的边。
+     */
+    M shortest_path(V s, V t, Workspace &fw, Workspace &bw) {
+        if (!check(s) || !check(t)) return {INF, {}};  // 检查越界
+        if (s == t) return {T(0), {{0, s}}};           // 起点和终点相同
+        prepare();
+        V from, to;
+        T cost;
+        T dist = search(s, t, fw, bw, from, to, cost);
+        if (dist == INF) return {INF, {}};  // 未找到路径
+
+        // 查询图上的路径 s ... from -> to ... t
+        std::vector<E> hops;
+        for (V cur = from; cur != NONE; cur = fw.prev[cur].second) hops.emplace_back(fw.prev[cur].first, cur);
+        std::reverse(hops.begin(), hops.end());
+        hops.emplace_back(cost, to);
+        for (V cur = to; bw.prev[cur].second != NONE; cur = bw.prev[cur].second)
+            hops.emplace_back(bw.prev[cur].first, bw.prev[cur].second);
+
+        std::vector<E> path{{0, s}};
+        auto &ws = thread_workspace<T, Q, 2>();
+        for (std::size_t i = 1; i < hops.size(); ++i) {
+            V a = hops[i - 1].second, b = hops[i].second;
+            int lvl = query_level(a, s, t);
+            if (lvl > 0 && levels[lvl - 1].cell[a] == levels[lvl - 1].cell[b])
+                unpack(lvl - 1, a, b, ws, path);  // clique 边
+            else
+                path.push_back(hops[i]);
+        }
+        return {dist, path};
+    }
+
+    M shortest_path(V s, V t) { return shortest_path(s, t, thread_workspace<T, Q, 0>(), thread_workspace<T, Q, 1>()); }
+
+    /**
+     * @brief 在第 l 层 a 所在的单元内用原图的边搜索 a -> b，把路径 (不含 a) 追加到 path。
+     */
+    void unpack(std::size_t l, V a, V b, Workspace &ws, std::vector<E> &path) const {
+        const auto &cell = levels[l].cell;
+        const V c = cell[a];
+        ws.reset(n);
+        ws.set(a, 0, {0, NONE});
+        ws.pq.push(0, a);
+        while (!ws.pq.empty()) {
+            auto [d, u] = ws.pq.top();
+            ws.pq.pop();
+            if (ws.dist[u] < d) continue;
+            if (u == b) break;
+            for (const auto &[cost, to] : g[u]) {
+                T cand = saturating_add(d, cost);
+                if (cell[to] != c || !(cand < ws.get(to, INF))) continue;
+                ws.set(to, cand, {cost, u});
+                ws.pq.push(cand, to);
+            }
+        }
+        std::size_t first = path.size();
+        for (V cur = b; cur != a; cur = ws.prev[cur].second) path.emplace_back(ws.prev[cur].first, cur);
+        std::reverse(path.begin() + first, path.end());
+    }
+};
+
+#endif
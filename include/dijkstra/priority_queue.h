@@ -0,0 +1,263 @@
+#ifndef PATH_PRIORITY_QUEUE_H
+#define PATH_PRIORITY_QUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * 搜索循环使用的优先队列策略，统一接口：
+ *   clear() / empty() / size()
+ *   push(d, u)  插入节点 u，键为 d；若 u 已在队列中则视为 decrease-key
+ *   top()       返回 (d, u) 最小的元素
+ *   pop()       删除最小元素
+ * 比较堆 (LazyBinaryHeap, IndexedDaryHeap) 出队顺序均按 (d, u) 字典序，因此得到的最短路径完全一致；
+ * 整数单调队列 (BucketQueue, RadixHeap) 要求 push 的键不小于最近一次出队的键，等距节点的出队顺序不作保证。
+ * 节点编号类型 V 见 weight.h 中的 NodeId，由 node_type 给出，SearchWorkspace 据此确定前驱数组的类型。
+ */
+
+/**
+ * @brief 惰性删除的二叉堆，push 总是插入新元素，旧元素出队时由调用方按 dist 判断过期并跳过。
+ *
+ * 与 std::priority_queue<E, std::vector<E>, std::greater<E>> 行为相同，但 clear() 时保留容量。
+ */
+template <typename T, typename V = std::uint32_t>
+struct LazyBinaryHeap {
+    using node_type = V;
+    using E = std::pair<T, V>;  // 权重, 节点
+
+    std::vector<E> heap;
+
+    void clear() { heap.clear(); }
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    void push(T d, V u) {
+        heap.emplace_back(d, u);
+        std::push_heap(heap.begin(), heap.end(), std::greater<E>());
+    }
+
+    const E &top() const { return heap.front(); }
+
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<E>());
+        heap.pop_back();
+    }
+};
+
+/**
+ * @brief 带索引的 D 叉堆，支持真正的 decrease-key，队列中每个节点至多出现一次，不会产生过期元素。
+ *
+ * pos 数组不需要在每次查询时重置：只有 pos[u] < size() 且 heap[pos[u]].second == u 时才认为 u 在堆中。
+ */
+template <typename T, int D = 4, typename V = std::uint32_t>
+struct IndexedDaryHeap {
+    static_assert(D >= 2, "IndexedDaryHeap requires D >= 2");
+    using node_type = V;
+    using E = std::pair<T, V>;  // 权重, 节点
+
+    std::vector<E> heap;
+    std::vector<std::size_t> pos;  // 节点在 heap 中的下标
+
+    void clear() { heap.clear(); }
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    bool contains(V u) const {
+        return static_cast<std::size_t>(u) < pos.size() && pos[u] < heap.size() && heap[pos[u]].second == u;
+    }
+
+    void push(T d, V u) {
+        if (static_cast<std::size_t>(u) >= pos.size()) pos.resize(std::max<std::size_t>(std::size_t(u) + 1, pos.size() * 2));
+        if (contains(u)) {
+            auto i = pos[u];
+            if (!(E{d, u} < heap[i])) return;  // 只接受更小的键
+            heap[i].first = d;
+            sift_up(i);
+        } else {
+            heap.emplace_back(d, u);
+            sift_up(heap.size() - 1);
+        }
+    }
+
+    const E &top() const { return heap.front(); }
+
+    void pop() {
+        heap.front() = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) sift_down(0);
+    }
+
+    void sift_up(std::size_t i) {
+        E e = heap[i];
+        while (i > 0) {
+            auto p = (i - 1) / D;
+            if (!(e < heap[p])) break;
+            place(i, heap[p]);
+            i = p;
+        }
+        place(i, e);
+    }
+
+    void sift_down(std::size_t i) {
+        E e = heap[i];
+        const std::size_t m = heap.size();
+        while (true) {
+            auto first = i * D + 1;
+            if (first >= m) break;
+            auto last = std::min(first + D, m);
+            auto best = first;
+            for (auto c = first + 1; c < last; ++c)
+                if (heap[c] < heap[best]) best = c;
+            if (!(heap[best] < e)) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, e);
+    }
+
+    void place(std::size_t i, const E &e) {
+        heap[i] = e;
+        pos[e.second] = i;
+    }
+};
+
+/**
+ * @brief Dial 算法的桶队列，适用于边权较小的非负整数。
+ *
+ * 使用长度为 2 的幂的环形桶数组，键 k 放在 ring[k & mask] 中；队列中的键始终落在 [cur, hi] 内且 hi - cur < ring.size()，
+ * 队列为空时 cur 取下一个插入的键，区间超出环长时自动扩容并重新分桶，因此不需要预先知道最大边权。
+ * push/pop 均摊 O(1)，扫描空桶的总代价不超过最大距离。
+ */
+template <typename T, typename V = std::uint32_t>
+struct BucketQueue {
+    static_assert(std::is_integral_v<T>, "BucketQueue requires an integral key type");
+    using node_type = V;
+    using E = std::pair<T, V>;  // 权重, 节点
+
+    std::vector<std::vector<E>> ring = std::vector<std::vector<E>>(64);
+    std::size_t mask = 63;
+    std::size_t count = 0;
+    T cur = 0;  // 当前最小键的下界
+    T hi = 0;   // 队列中键的上界
+
+    void clear() {
+        if (count)
+            for (auto &b : ring) b.clear();
+        count = 0;
+        cur = hi = 0;
+    }
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    void push(T d, V u) {
+        if (count == 0)
+            cur = hi = d;  // 空队列从 d 重新开始，clear 后插入很大的键不会把环扩到 d 那么大
+        else if (d < cur)
+            cur = d;  // 低于下界的键 (如 Dijkstra::repair 按任意顺序插入)：下移下界
+        hi = std::max(hi, d);
+        if (static_cast<std::size_t>(hi - cur) > mask) grow(static_cast<std::size_t>(hi - cur) + 1);
+        ring[static_cast<std::size_t>(d) & mask].emplace_back(d, u);
+        ++count;
+    }
+
+    const E &top() {
+        while (ring[static_cast<std::size_t>(cur) & mask].empty()) ++cur;
+        return ring[static_cast<std::size_t>(cur) & mask].back();
+    }
+
+    void pop() {
+        top();
+        ring[static_cast<std::size_t>(cur) & mask].pop_back();
+        --count;
+    }
+
+    void grow(std::size_t span) {
+        std::vector<std::vector<E>> old(std::bit_ceil(span));
+        old.swap(ring);
+        mask = ring.size() - 1;
+        for (auto &b : old)
+            for (auto &e : b) ring[static_cast<std::size_t>(e.first) & mask].push_back(e);
+    }
+};
+
+/**
+ * @brief 单调整数键的基数堆 (radix heap)。
+ *
+ * 键 k 放在第 bit_width(k ^ last) 个桶中，last 为最近一次出队的键；第 0 个桶为空时，
+ * 取第一个非空桶的最小键作为新的 last 并把该桶重新分配到更低的桶里。每个元素最多被移动 O(log C) 次。
+ */
+template <typename T, typename V = std::uint32_t>
+struct RadixHeap {
+    static_assert(std::is_integral_v<T>, "RadixHeap requires an integral key type");
+    using node_type = V;
+    using E = std::pair<T, V>;  // 权重, 节点
+    using U = std::make_unsigned_t<T>;
+    static constexpr int B = std::numeric_limits<U>::digits + 1;
+
+    std::array<std::vector<E>, B> buckets;
+    std::size_t count = 0;
+    U last = 0;
+
+    void clear() {
+        if (count)
+            for (auto &b : buckets) b.clear();
+        count = 0;
+        last = 0;
+    }
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    static int bucket(U k, U base) { return std::bit_width(static_cast<U>(k ^ base)); }
+
+    void push(T d, V u) {
+        buckets[bucket(static_cast<U>(d), last)].emplace_back(d, u);
+        ++count;
+    }
+
+    const E &top() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            auto &b = buckets[i];
+            last = static_cast<U>(std::min_element(b.begin(), b.end())->first);
+            for (auto &e : b) buckets[bucket(static_cast<U>(e.first), last)].push_back(e);
+            b.clear();
+        }
+        return buckets[0].back();
+    }
+
+    void pop() {
+        top();
+        buckets[0].pop_back();
+        --count;
+    }
+};
+
+/**
+ * @brief 默认的队列策略：整数边权使用基数堆，浮点边权使用比较堆。
+ */
+template <typename T, typename V = std::uint32_t>
+using DefaultQueue = std::conditional_t<std::is_integral_v<T>, RadixHeap<T, V>, LazyBinaryHeap<T, V>>;
+
+/**
+ * @brief 记录队列历史最大长度的包装，用于基准测试中比较不同策略的堆大小。
+ */
+template <typename Q>
+struct PeakTrackingQueue : Q {
+    std::size_t peak = 0;
+
+    template <typename T>
+    void push(T d, typename Q::node_type u) {
+        Q::push(d, u);
+        peak = std::max(peak, this->size());
+    }
+};
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef PATH_REORDER_H
+#define PATH_REORDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "shortest_path_tree.h"
+#include "weight.h"
+
+/**
+ * 为提高缓存局部性而对节点重新编号。
+ *
+ * 上游给出的节点编号往往是任意的，相邻节点分散在 dist / prev 和邻接数组的各处。这里提供几种编号方式：
+ *   bfs_order / dfs_order   按遍历顺序编号，相邻节点的编号也相近
+ *   rcm_order               逆 Cuthill-McKee，使邻接矩阵的带宽尽量小
+ *   hilbert_order           按坐标在 Hilbert 曲线上的位置编号，需要节点坐标
+ * reorder 用新编号重建引擎，返回的 Reordered 在接口处自动转换编号，调用方始终使用原来的编号。
+ */
+
+/**
+ * @brief 外部编号与内部编号之间的双向映射。
+ */
+template <NodeId V = std::uint32_t>
+struct NodeOrder {
+    static constexpr V NONE = no_node<V>();
+    std::vector<V> to_internal;  // 外部编号 -> 内部编号
+    std::vector<V> to_external;  // 内部编号 -> 外部编号
+
+    /**
+     * @brief 由访问序列构造：seq[i] 为内部编号为 i 的节点的外部编号，seq 必须是 0..n-1 的排列。
+     */
+    static NodeOrder from_sequence(std::vector<V> seq) {
+        NodeOrder o;
+        o.to_internal.assign(seq.size(), NONE);
+        for (std::size_t i = 0; i < seq.size(); ++i) o.to_internal[seq[i]] = static_cast<V>(i);
+        o.to_external = std::move(seq);
+        return o;
+    }
+
+    static NodeOrder identity(V n) {
+        std::vector<V> seq(n);
+        std::iota(seq.begin(), seq.end(), V(0));
+        return from_sequence(std::move(seq));
+    }
+
+    V size() const { return static_cast<V>(to_internal.size()); }
+
+    // 越界的编号映射为 NONE，交给引擎的 check 处理
+    V internal(V u) const { return u < size() ? to_internal[u] : NONE; }
+    V external(V v) const { return v < size() ? to_external[v] : NONE; }
+};
+
+/**
+ * @brief 按 order 重新编号后的图，每个节点的出边保持原来的顺序。
+ */
+template <typename T, NodeId V>
+CSRGraph<T, V> permute_graph(const CSRGraph<T, V> &g, const NodeOrder<V> &order) {
+    CSRGraph<T, V> out(g.n);
+    for (V v = 0; v < g.n; ++v) out.offsets[v + 1] = out.offsets[v] + g.degree(order.to_external[v]);
+    out.targets.resize(g.edge_count());
+    out.weights.resize(g.edge_count());
+    std::size_t i = 0;
+    for (V v = 0; v < g.n; ++v)
+        for (const auto &[c, to] : g[order.to_external[v]]) {
+            out.targets[i] = order.to_internal[to];
+            out.weights[i++] = c;
+        }
+    return out;
+}
+
+namespace reorder_detail {
+
+/**
+ * @brief 忽略方向后的邻接表，用于遍历类的编号，使只有入边的节点也能被相邻的节点带到。
+ */
+template <typename T, NodeId V>
+CSRGraph<T, V> undirected(const CSRGraph<T, V> &g) {
+    CSRBuilder<T, V> b(g.n);
+    b.src.reserve(2 * g.edge_count()), b.dst.reserve(2 * g.edge_count()), b.cost.reserve(2 * g.edge_count());
+    for (V u = 0; u < g.n; ++u)
+        for (const auto &[c, to] : g[u]) b.add(u, to, c), b.add(to, u, c);
+    return b.build();
+}
+
+}  // namespace reorder_detail
+
+/**
+ * @brief 广度优先编号，依次从编号最小的未访问节点开始，覆盖所有连通分量。
+ */
+template <typename T, NodeId V>
+NodeOrder<V> bfs_order(const CSRGraph<T, V> &g) {
+    auto adj = reorder_detail::undirected(g);
+    std::vector<V> seq;
+    seq.reserve(g.n);
+    std::vector<char> seen(g.n, 0);
+    for (V root = 0; root < g.n; ++root) {
+        if (seen[root]) continue;
+        seen[root] = 1;
+        seq.push_back(root);
+        for (std::size_t head = seq.size() - 1; head < seq.size(); ++head)
+            for (const auto &[c, to] : adj[seq[head]])
+                if (!seen[to]) seen[to] = 1, seq.push_back(to);
+    }
+    return NodeOrder<V>::from_sequence(std::move(seq));
+}
+
+/**
+ * @brief 深度优先 (前序) 编号，用显式栈实现，不受递归深度限制。
+ */
+template <typename T, NodeId V>
+NodeOrder<V> dfs_order(const CSRGraph<T, V> &g) {
+    auto adj = reorder_detail::undirected(g);
+    std::vector<V> seq;
+    seq.reserve(g.n);
+    std::vector<char> seen(g.n, 0);
+    std::vector<std::pair<V, std::size_t>> stack;  // 节点, 下一条要检查的边
+    for (V root = 0; root < g.n; ++root) {
+        if (seen[root]) continue;
+        seen[root] = 1, seq.push_back(root);
+        stack.emplace_back(root, adj.offsets[root]);
+        while (!stack.empty()) {
+            auto &[v, i] = stack.back();
+            if (i == adj.offsets[v + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            V to = adj.targets[i++];
+            if (!seen[to]) {
+                seen[to] = 1, seq.push_back(to);
+                stack.emplace_back(to, adj.offsets[to]);
+            }
+        }
+    }
+    return NodeOrder<V>::from_sequence(std::move(seq));
+}
+
+/**
+ * @brief 逆 Cuthill-McKee 编号：每个连通分量从度数最小的节点开始广度优先遍历，
+ * 同一节点的未访问邻居按度数从小到大加入，最后把整个序列反转。
+ */
+template <typename T, NodeId V>
+NodeOrder<V> rcm_order(const CSRGraph<T, V> &g) {
+    auto adj = reorder_detail::undirected(g);
+    std::vector<V> by_degree(g.n);
+    std::iota(by_degree.begin(), by_degree.end(), V(0));
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](V a, V b) { return adj.degree(a) < adj.degree(b); });
+
+    std::vector<V> seq;
+    seq.reserve(g.n);
+    std::vector<char> seen(g.n, 0);
+    for (V root : by_degree) {
+        if (seen[root]) continue;
+        seen[root] = 1;
+        seq.push_back(root);
+        for (std::size_t head = seq.size() - 1; head < seq.size(); ++head) {
+            auto first = seq.size();
+            for (const auto &[c, to] : adj[seq[head]])
+                if (!seen[to]) seen[to] = 1, seq.push_back(to);
+            std::stable_sort(seq.begin() + first, seq.end(),
+                             [&](V a, V b) { return adj.degree(a) < adj.degree(b); });
+        }
+    }
+    std::reverse(seq.begin(), seq.end());
+    return NodeOrder<V>::from_sequence(std::move(seq));
+}
+
+/**
+ * @brief (x, y) 在 2^bits x 2^bits 网格上的 Hilbert 曲线序号。
+ */
+inline std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y, int bits = 16) {
+    const std::uint32_t side = std::uint32_t(1) << bits;
+    std::uint64_t d = 0;
+    for (std::uint32_t s = side >> 1; s > 0; s >>= 1) {
+        std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {  // 旋转象限
+            if (rx == 1) x = side - 1 - x, y = side - 1 - y;
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/**
+ * @brief 按坐标的 Hilbert 曲线序号编号，coords[u] 为外部编号 u 的 (x, y)，例如 load_dimacs_coordinates 的结果。
+ */
+template <NodeId V = std::uint32_t>
+NodeOrder<V> hilbert_order(const std::vector<std::pair<double, double>> &coords) {
+    const V n = static_cast<V>(coords.size());
+    double x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+    if (n > 0) x0 = x1 = coords[0].first, y0 = y1 = coords[0].second;
+    for (const auto &[x, y] : coords) {
+        x0 = std::min(x0, x), x1 = std::max(x1, x);
+        y0 = std::min(y0, y), y1 = std::max(y1, y);
+    }
+    const double scale = 65535 / std::max({x1 - x0, y1 - y0, 1e-12});  // 保持长宽比
+
+    std::vector<std::pair<std::uint64_t, V>> key(n);
+    for (V v = 0; v < n; ++v) {
+        auto qx = static_cast<std::uint32_t>(std::lround((coords[v].first - x0) * scale));
+        auto qy = static_cast<std::uint32_t>(std::lround((coords[v].second - y0) * scale));
+        key[v] = {hilbert_index(qx, qy), v};
+    }
+    std::sort(key.begin(), key.end());
+    std::vector<V> seq(n);
+    for (V i = 0; i < n; ++i) seq[i] = key[i].second;
+    return NodeOrder<V>::from_sequence(std::move(seq));
+}
+
+/**
+ * @brief 在重新编号的引擎外包一层编号转换，接口与原引擎相同，参数和结果都使用外部编号。
+ *
+ * @tparam Engine Dijkstra 或 BiDirDijkstra
+ */
+template <typename Engine>
+struct Reordered {
+    using T = typename Engine::E::first_type;
+    using V = typename Engine::E::second_type;
+    Engine engine;  // 使用内部编号
+    NodeOrder<V> order;
+
+    template <typename... Ws>
+    auto shortest_dist(V s, V t, Ws &...ws) {
+        return engine.shortest_dist(order.internal(s), order.internal(t), ws...);
+    }
+
+    template <typename... Ws>
+    auto shortest_path(V s, V t, Ws &...ws) {
+        auto ans = engine.shortest_path(order.internal(s), order.internal(t), ws...);
+        for (auto &e : ans.second) e.second = order.to_external[e.second];
+        return ans;
+    }
+
+    template <typename... Ws>
+    auto dijkstra(V s, Ws &...ws) {
+        auto tree = engine.dijkstra(order.internal(s), ws...);
+        if (tree.size() == 0) return tree;
+        decltype(tree) out;
+        out.source = s;
+        out.dist.resize(tree.size());
+        out.prev.resize(tree.size());
+        for (V v = 0; v < tree.size(); ++v) {
+            V u = order.to_external[v], p = tree.prev[v].second;
+            out.dist[u] = tree.dist[v];
+            out.prev[u] = {tree.prev[v].first, p == tree.NONE ? p : order.to_external[p]};
+        }
+        return out;
+    }
+
+    template <typename... Pool>
+    auto distance_matrix(std::vector<V> sources, std::vector<V> targets, Pool &...pool) {
+        for (V &s : sources) s = order.internal(s);
+        for (V &t : targets) t = order.internal(t);
+        return engine.distance_matrix(sources, targets, pool...);
+    }
+
+    template <typename... Ws>
+    auto shortest_paths(V s, std::vector<V> targets, Ws &...ws) {
+        for (V &t : targets) t = order.internal(t);
+        auto ans = engine.shortest_paths(order.internal(s), targets, ws...);
+        for (auto &[dist, path] : ans)
+            for (auto &e : path) e.second = order.to_external[e.second];
+        return ans;
+    }
+
+    template <typename... Ws>
+    auto within(std::span<const V> sources, T radius, Ws &...ws) {
+        auto ans = engine.within(internal(sources), radius, ws...);
+        for (auto &e : ans) e.second = order.to_external[e.second];
+        return ans;
+    }
+
+    template <typename... Ws>
+    auto within(V s, T radius, Ws &...ws) {
+        return within(std::span<const V>(&s, 1), radius, ws...);
+    }
+
+    // pred 接收外部编号
+    template <typename Pred, typename... Ws>
+    auto k_nearest(std::span<const V> sources, std::size_t k, Pred &&pred, Ws &...ws) {
+        auto ans = engine.k_nearest(
+            internal(sources), k, [&](V v) { return pred(order.to_external[v]); }, ws...);
+        for (auto &e : ans) e.second = order.to_external[e.second];
+        return ans;
+    }
+
+    template <typename Pred>
+    auto k_nearest(V s, std::size_t k, Pred &&pred) {
+        return k_nearest(std::span<const V>(&s, 1), k, pred);
+    }
+
+    auto k_nearest(V s, std::size_t k) {
+        return k_nearest(s, k, [](V) { return true; });
+    }
+
+    /**
+     * @brief 把一组外部编号转换为内部编号，越界的编号转换为 NONE。
+     */
+    std::vector<V> internal(std::span<const V> nodes) const {
+        std::vector<V> out(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i) out[i] = order.internal(nodes[i]);
+        return out;
+    }
+};
+
+/**
+ * @brief 按 order 重新编号 engine 的图 (包括 BiDirDijkstra 的反向图)，构造新的引擎。原引擎保持不变。
+ *
+ * 引擎的 concurrent / index_reachability / delta 设置一并复制，可达性索引在新引擎上按新编号重建。
+ */
+template <typename Engine>
+Reordered<Engine> reorder(Engine &engine, NodeOrder<typename Engine::E::second_type> order) {
+    if (order.size() != engine.n) throw std::invalid_argument("node order does not match the graph");
+    engine.finalize();
+    auto build = [&] {
+        if constexpr (requires { Engine(engine.g, engine.gr); })  // 由正反两个图构造的引擎
+            return Engine(permute_graph(engine.g, order), permute_graph(engine.gr, order));
+        else
+            return Engine(permute_graph(engine.g, order));
+    };
+    Reordered<Engine> out{build(), std::move(order)};
+    if constexpr (requires { engine.concurrent; }) out.engine.concurrent = engine.concurrent;
+    if constexpr (requires { engine.index_reachability; }) out.engine.index_reachability = engine.index_reachability;
+    if constexpr (requires { engine.delta; }) out.engine.delta = engine.delta;
+    out.engine.finalize();
+    return out;
+}
+
+#endif
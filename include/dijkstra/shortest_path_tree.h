@@ -0,0 +1,105 @@
+#ifndef PATH_SHORTEST_PATH_TREE_H
+#define PATH_SHORTEST_PATH_TREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "weight.h"
+
+/**
+ * @brief 一对多搜索的结果：只保存每个节点的距离和前驱，路径在需要时沿前驱树回溯生成。
+ *
+ * 与为每个节点展开完整路径相比，内存和构造时间都是 O(n)。
+ *
+ * @tparam T 边权类型
+ * @tparam V 节点编号类型，见 NodeId
+ */
+template <Weight T, NodeId V = std::uint32_t>
+struct ShortestPathTree {
+    static constexpr T INF = infinity<T>();  // 不可达的距离
+    static constexpr V NONE = no_node<V>();  // 没有前驱
+    using E = std::pair<T, V>;               // 权重, 节点
+    using P = std::pair<T, std::vector<E>>;  // 最短路径长度，具体路径
+
+    V source = NONE;
+    std::vector<T> dist;  // 不可达为 INF
+    std::vector<E> prev;  // (进入该节点的边权, 前驱节点)，起点和不可达节点的前驱为 NONE
+
+    ShortestPathTree() = default;
+
+    /**
+     * @brief 从搜索工作区中复制前 n 个节点的距离和前驱。
+     */
+    template <typename Workspace>
+    ShortestPathTree(V s, V n, const Workspace &ws) : source(s), dist(n, INF), prev(n, {0, NONE}) {
+        for (V i = 0; i < n; ++i)
+            if (ws.reached(i)) dist[i] = ws.dist[i], prev[i] = ws.prev[i];
+    }
+
+    V size() const { return static_cast<V>(dist.size()); }
+    bool reached(V v) const { return v < size() && dist[v] != INF; }
+
+    /**
+     * @brief 从 v 沿前驱回溯到起点的迭代器，依次产生 (进入该节点的边权, 节点)，顺序为终点到起点。
+     */
+    struct Iterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = E;
+
+        const ShortestPathTree *tree = nullptr;
+        V cur = NONE;
+
+        E operator*() const { return {tree->prev[cur].first, cur}; }
+        Iterator &operator++() {
+            cur = tree->prev[cur].second;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const Iterator &o) const { return cur == o.cur; }
+    };
+
+    struct Range {
+        Iterator first;
+        Iterator begin() const { return first; }
+        Iterator end() const { return {first.tree, NONE}; }
+    };
+
+    /**
+     * @brief 到 v 的路径的逆序视图，不分配内存；不可达时为空。
+     */
+    Range walk(V v) const { return {{this, reached(v) ? v : NONE}}; }
+
+    /**
+     * @brief 把从起点到 v 的路径按正序写入 path (先清空)，返回到 v 的距离；不可达时 path 为空并返回 INF。
+     */
+    T path_to(V v, std::vector<E> &path) const {
+        path.clear();
+        if (!reached(v)) return INF;
+        for (auto e : walk(v)) path.push_back(e);
+        std::reverse(path.begin(), path.end());
+        return dist[v];
+    }
+
+    /**
+     * @brief 展开到 v 的 (最短路径长度, 路径)，每次调用都会分配新的路径数组。
+     */
+    P operator[](V v) const {
+        P ans{INF, {}};
+        ans.first = path_to(v, ans.second);
+        return ans;
+    }
+
+    bool operator==(const ShortestPathTree &) const = default;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef PATH_STATS_H
+#define PATH_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * 搜索循环的统计策略，统一接口：
+ *   reset()          新查询开始时清零，由 SearchWorkspace::reset 调用
+ *   on_pop(stale)    出队一个元素，stale 表示该元素已过期
+ *   on_settle()      确定一个节点
+ *   on_scan()        扫描一条边
+ *   on_relax()       松弛成功 (距离被更新)
+ *   on_push()        入队一个元素
+ *   on_meet()        双向搜索中更新了相遇点 / 最优估计
+ *   phase(p)         返回计时守卫，析构时把经过的时间累加到阶段 p
+ * NoStats 的所有方法都是空的内联函数，编译后搜索循环中不留下任何代码。
+ */
+
+/**
+ * @brief 查询阶段，用于分阶段计时。
+ */
+enum class Phase : int {
+    Init,    // 工作区重置与起点入队
+    Search,  // 主搜索循环
+    Path,    // 路径回溯 / 结果构造
+    Count,
+};
+
+/**
+ * @brief 一次查询的统计数据。双向搜索的两个方向分别记在各自的工作区中，可以用 += 合并。
+ */
+struct QueryStats {
+    std::size_t settled = 0;       // 确定的节点数
+    std::size_t scanned = 0;       // 扫描的边数
+    std::size_t relaxed = 0;       // 成功松弛的边数
+    std::size_t pushes = 0;        // 入队次数
+    std::size_t pops = 0;          // 出队次数，包含过期元素
+    std::size_t stale = 0;         // 过期的出队次数
+    std::size_t meet_updates = 0;  // 相遇点更新次数
+    std::array<std::int64_t, static_cast<int>(Phase::Count)> phase_ns{};  // 各阶段耗时，单位纳秒
+
+    std::int64_t time_ns(Phase p) const { return phase_ns[static_cast<int>(p)]; }
+
+    QueryStats &operator+=(const QueryStats &o) {
+        settled += o.settled, scanned += o.scanned, relaxed += o.relaxed;
+        pushes += o.pushes, pops += o.pops, stale += o.stale, meet_updates += o.meet_updates;
+        for (std::size_t i = 0; i < phase_ns.size(); ++i) phase_ns[i] += o.phase_ns[i];
+        return *this;
+    }
+
+    friend QueryStats operator+(QueryStats a, const QueryStats &b) { return a += b; }
+};
+
+/**
+ * @brief 不统计任何数据的默认策略。
+ */
+struct NoStats {
+    static constexpr bool enabled = false;
+    struct Timer {};
+
+    void reset() {}
+    void on_pop(bool) {}
+    void on_settle() {}
+    void on_scan() {}
+    void on_relax() {}
+    void on_push() {}
+    void on_meet() {}
+    Timer phase(Phase) { return {}; }
+};
+
+/**
+ * @brief 只计数不计时的策略，计数结果即本对象的 QueryStats 部分。
+ */
+struct CountingStats : QueryStats {
+    static constexpr bool enabled = true;
+    struct Timer {};
+
+    void reset() { static_cast<QueryStats &>(*this) = {}; }
+    void on_pop(bool is_stale) { ++pops, stale += is_stale; }
+    void on_settle() { ++settled; }
+    void on_scan() { ++scanned; }
+    void on_relax() { ++relaxed; }
+    void on_push() { ++pushes; }
+    void on_meet() { ++meet_updates; }
+    Timer phase(Phase) { return {}; }
+};
+
+/**
+ * @brief 计数并按阶段计时的策略，每个阶段额外两次 steady_clock 读数。
+ */
+struct TimedStats : CountingStats {
+    struct Timer {
+        std::int64_t *slot;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Timer(std::int64_t *slot) : slot(slot) {}
+        Timer(const Timer &) = delete;
+        ~Timer() {
+            *slot += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                         .count();
+        }
+    };
+
+    Timer phase(Phase p) { return {&phase_ns[static_cast<int>(p)]}; }
+};
+
+#endif
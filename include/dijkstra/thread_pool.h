@@ -0,0 +1,169 @@
+#ifndef PATH_THREAD_POOL_H
+#define PATH_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 常驻线程池，parallel_for 使用区间窃取 (work stealing) 调度。
+ *
+ * 每个工作线程初始分到一段连续的下标区间，从区间头部逐个取任务；自己的区间取完后，
+ * 从其他线程的区间尾部窃取一半。调用 parallel_for 的线程作为 0 号工作线程参与计算。
+ * 多个线程同时调用同一个线程池的 parallel_for 时依次执行 (例如多个查询线程共用 default_thread_pool)。
+ * 任务抛出异常时其余线程不再领取新任务，等所有线程停下后在调用线程上重新抛出第一个异常。
+ */
+struct ThreadPool {
+    struct alignas(64) Slot {
+        std::mutex m;
+        std::size_t begin = 0, end = 0;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<Slot> slots;
+    std::function<void(std::size_t, int)> job;
+    std::mutex caller;  // 同一时刻只有一个 parallel_for 在执行
+    std::mutex m;
+    std::condition_variable wake, finished;
+    std::size_t round = 0;  // 每次 parallel_for 递增，用于唤醒工作线程
+    int running = 0;        // 仍在执行本轮任务的后台线程数
+    bool stopping = false;
+    std::exception_ptr error;        // 本轮第一个任务异常，由 m 保护
+    std::atomic<bool> failed{false};  // 本轮已有任务抛出异常，其余线程停止领取任务
+
+    explicit ThreadPool(int threads = std::max(1u, std::thread::hardware_concurrency()))
+        : slots(std::max(1, threads)) {
+        for (int id = 1; id < size(); ++id) workers.emplace_back([this, id] { loop(id); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int size() const { return static_cast<int>(slots.size()); }
+
+    /**
+     * @brief 并行执行 fn(i, worker)，i 取遍 [0, count)，worker 为执行该任务的线程编号 [0, size())。
+     *
+     * 返回时所有任务都已完成。其他线程的并发调用会等待本次结束；不可重入：fn 中不能再调用同一个线程池的 parallel_for。
+     * fn 抛出异常时尚未开始的任务被放弃，所有线程停下后重新抛出第一个异常，线程池仍可继续使用。
+     */
+    void parallel_for(std::size_t count, std::function<void(std::size_t, int)> fn) {
+        if (count == 0) return;
+        std::lock_guard<std::mutex> serial(caller);
+        const std::size_t p = slots.size();
+        for (std::size_t i = 0; i < p; ++i) {
+            std::lock_guard<std::mutex> lock(slots[i].m);
+            slots[i].begin = count * i / p;
+            slots[i].end = count * (i + 1) / p;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m);
+            job = std::move(fn);
+            error = nullptr;
+            failed = false;
+            running = size() - 1;
+            ++round;
+        }
+        wake.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock(m);
+        finished.wait(lock, [&] { return running == 0; });
+        job = nullptr;
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+
+    void loop(int id) {
+        std::size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                wake.wait(lock, [&] { return stopping || round != seen; });
+                if (stopping) return;
+                seen = round;
+            }
+            work(id);
+            {
+                std::lock_guard<std::mutex> lock(m);
+                --running;
+            }
+            finished.notify_one();
+        }
+    }
+
+    void work(int id) {
+        auto &own = slots[id];
+        while (!failed.load(std::memory_order_relaxed)) {
+            std::size_t i = 0;
+            bool got = false;
+            {
+                std::lock_guard<std::mutex> lock(own.m);
+                if (own.begin < own.end) i = own.begin++, got = true;
+            }
+            if (!got) {
+                if (!steal(id)) return;
+                continue;
+            }
+            try {
+                job(i, id);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m);
+                if (!error) error = std::current_exception();
+                failed = true;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief 从其他线程的区间尾部窃取一半任务放到自己的区间，没有可窃取的任务时返回 false。
+     */
+    bool steal(int id) {
+        const int p = size();
+        for (int k = 1; k < p; ++k) {
+            auto &victim = slots[(id + k) % p];
+            std::size_t b, e;
+            {
+                std::lock_guard<std::mutex> lock(victim.m);
+                if (victim.begin >= victim.end) continue;
+                e = victim.end;
+                b = victim.begin + (victim.end - victim.begin) / 2;
+                victim.end = b;
+            }
+            if (b == e) continue;
+            std::lock_guard<std::mutex> lock(slots[id].m);
+            slots[id].begin = b;
+            slots[id].end = e;
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief 进程内共享的默认线程池，线程数为硬件并发数。
+ */
+inline ThreadPool &default_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+#endif
@@ -1,15 +1,21 @@
 #ifndef UTILS_H
 #define UTILS_H
 #include <format>
+#include <iostream>
 #include <sstream>
 
-void print_shortest_path(const auto& short_paths) {
-    for (int i = 0; i < short_paths.size(); ++i) {
+#include "shortest_path_tree.h"
+
+template <Weight T, NodeId V>
+void print_shortest_path(const ShortestPathTree<T, V>& tree) {
+    std::vector<typename ShortestPathTree<T, V>::E> buffer;  // 所有节点复用同一个路径缓冲区
+    for (V i = 0; i < tree.size(); ++i) {
         std::ostringstream path;
         std::ostringstream cos;
         bool first_element = true;
 
-        for (const auto& e : short_paths[i].second) {
+        T dist = tree.path_to(i, buffer);
+        for (const auto& e : buffer) {
             if (first_element) {
                 path << e.second;
                 cos << e.first;
@@ -21,11 +27,11 @@ void print_shortest_path(const auto& short_paths) {
         }
 
         std::cout << std::format("node: {0: <5} dist: {1: <5} path: {2: <20} cost: {3: <20}", i,
-                                 short_paths[i].first, path.str(), cos.str())
+                                 dist, path.str(), cos.str())
                   << std::endl;
 
         // std::cout << "node: " << std::left << std::setw(5) << i << "dis: " << std::left
-        //           << std::setw(5) << short_paths[i].first << "path: " << std::left <<
+        //           << std::setw(5) << dist << "path: " << std::left <<
         //           std::setw(20)
         //           << path.str() << "cos: " << std::left << std::setw(20) << cos.str() <<
         //           std::endl;
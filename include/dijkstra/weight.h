@@ -0,0 +1,54 @@
+#ifndef PATH_WEIGHT_H
+#define PATH_WEIGHT_H
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief 边权类型：任意非 bool 的算术类型，包括无符号整数和浮点数。
+ */
+template <typename T>
+concept Weight = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+/**
+ * @brief 搜索内部使用的无穷大：浮点数为 +inf，整数为类型的最大值。
+ *
+ * 未到达的节点按距离为 infinity 处理，松弛只需一次比较 cand < dist，不需要先判断是否已到达；
+ * 对外接口同样以 infinity 表示不可达，无符号边权也能与合法距离区分开。
+ */
+template <Weight T>
+constexpr T infinity() {
+    if constexpr (std::is_floating_point_v<T>)
+        return std::numeric_limits<T>::infinity();
+    else
+        return std::numeric_limits<T>::max();
+}
+
+/**
+ * @brief 节点编号类型：32 位或 64 位无符号整数。节点数不超过 2^32 - 1 的图用 uint32_t 即可，邻接数组只有一半大。
+ */
+template <typename N>
+concept NodeId = std::same_as<N, std::uint32_t> || std::same_as<N, std::uint64_t>;
+
+/**
+ * @brief 表示“没有节点”的编号 (类型的最大值)：起点的前驱、不限定终点的搜索、未找到的相遇点等。
+ */
+template <NodeId N>
+constexpr N no_node() {
+    return std::numeric_limits<N>::max();
+}
+
+/**
+ * @brief 非负边权的饱和加法：整数溢出时取 infinity，因此超出类型范围的路径视为不可达，而不会回绕成很小的距离。
+ */
+template <Weight T>
+constexpr T saturating_add(T a, T b) {
+    if constexpr (std::is_floating_point_v<T>)
+        return a + b;
+    else
+        return b > infinity<T>() - a ? infinity<T>() : T(a + b);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef PATH_WORKSPACE_H
+#define PATH_WORKSPACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "priority_queue.h"
+#include "stats.h"
+
+/**
+ * @brief 可复用的查询工作区。
+ *
+ * dist/prev 数组只在第一次使用时分配，之后每次查询通过递增 generation 惰性重置：
+ * 只有 stamp[u] == generation 的节点才被视为本次查询访问过，
+ * 因此一次查询的开销只与实际访问的节点数有关，而不是 O(n)。
+ *
+ * Q 为优先队列策略，见 priority_queue.h，节点编号类型取 Q::node_type；S 为统计策略，见 stats.h，默认不统计。
+ */
+template <typename T, typename Q = DefaultQueue<T>, typename S = NoStats>
+struct SearchWorkspace {
+    using V = typename Q::node_type;
+    using E = std::pair<T, V>;  // 权重, 节点
+
+    std::vector<T> dist;               // 距离
+    std::vector<E> prev;               // 记录cost和前驱节点
+    std::vector<std::uint32_t> stamp;  // 每个节点最后一次被写入时的 generation
+    std::uint32_t generation = 0;
+    Q pq;
+    std::size_t settled = 0;  // 本次查询确定 (出队且未过期) 的节点数
+    [[no_unique_address]] S stats;
+
+    /**
+     * @brief 为一次新的查询做准备，数组只增不减，多个不同规模的图可以共用同一个工作区。
+     *
+     * @param n 图的节点数
+     */
+    void reset(V n) {
+        if (stamp.size() < static_cast<std::size_t>(n)) {
+            dist.resize(n);
+            prev.resize(n);
+            stamp.resize(n, 0);
+        }
+        if (++generation == 0) {  // generation 回绕，整体清零一次
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        pq.clear();
+        settled = 0;
+        stats.reset();
+    }
+
+    bool reached(V u) const { return stamp[u] == generation; }
+
+    T get(V u, T inf) const { return reached(u) ? dist[u] : inf; }
+
+    void set(V u, T d) {
+        stamp[u] = generation;
+        dist[u] = d;
+    }
+
+    void set(V u, T d, E p) {
+        set(u, d);
+        prev[u] = p;
+    }
+
+    /**
+     * @brief 并发搜索中的 set：另一个线程可能同时通过 peek 读取 dist / stamp，因此以原子操作写入。
+     * 先写距离再以 release 写 stamp，读到本次 generation 的线程不会读到上一次查询留下的距离。
+     */
+    void publish(V u, T d, E p) {
+        prev[u] = p;
+        std::atomic_ref<T>(dist[u]).store(d, std::memory_order_relaxed);
+        if (stamp[u] != generation) std::atomic_ref<std::uint32_t>(stamp[u]).store(generation, std::memory_order_release);
+    }
+
+    /**
+     * @brief 在另一个线程中读取 publish 写入的距离，未到达时返回 inf。
+     * 读到的可能是本次查询中较早写入的 (更大的) 值，但总是某条真实路径的长度。
+     */
+    T peek(V u, T inf) {
+        if (std::atomic_ref<std::uint32_t>(stamp[u]).load(std::memory_order_acquire) != generation) return inf;
+        return std::atomic_ref<T>(dist[u]).load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief 当前线程的工作区，每个线程、每个 (T, Q, Slot, S) 组合只分配一次。
+ *
+ * 双向搜索同时需要两个工作区，分别使用 Slot 0 和 Slot 1。
+ */
+template <typename T, typename Q = DefaultQueue<T>, int Slot = 0, typename S = NoStats>
+SearchWorkspace<T, Q, S> &thread_workspace() {
+    thread_local SearchWorkspace<T, Q, S> ws;
+    return ws;
+}
+
+#endif
@@ -1,94 +1,272 @@
-#define DOCTEST_CONFIG_IMPLEMENT
-#define ANKERL_NANOBENCH_IMPLEMENT
-#include <iomanip>
-#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/contraction_hierarchy.h"
+#include "dijkstra/csr_graph.h"
 #include "dijkstra/dijkstra.h"
-#include "dijkstra/utils.h"
-
-void get_result() {
-    // spdlog::set_level(spdlog::level::debug);
-    {
-        Dijkstra<int> d(6);
-        d.add_edge(0, 1, 1);
-        d.add_edge(1, 2, 2);
-        d.add_edge(2, 3, 2);
-        d.add_edge(3, 4, 1);
-        d.add_edge(1, 3, 3);
-        using E = std::pair<int, int>;
-
-        auto short_paths = d.dijkstra(0);
-        print_shortest_path(short_paths);
+#include "dijkstra/graph_file.h"
+#include "dijkstra/graph_loader.h"
+#include "dijkstra/thread_pool.h"
+#include "dijkstra/workspace.h"
+
+/**
+ * shorthpath_run：批量最短路查询。加载图后从文件或标准输入读取查询，分块交给线程池，
+ * 每个线程使用自己的工作区；结果按输入顺序写出，最后在标准错误输出吞吐量和延迟分位数。
+ */
+
+static const char *USAGE = R"(usage: shorthpath_run [options] GRAPH
+  GRAPH 以 .csr 结尾时 mmap 二进制 CSR 文件 (见 shortpath_convert)，否则按 DIMACS .gr 或 "u v w" 边表解析
+  --engine=dijkstra|bidir|ch  点对点查询使用的引擎 (默认 bidir)
+  --weights=int|double        边权类型 (默认 int)
+  --threads=N                 线程数 (默认为硬件线程数)
+  --queries=FILE              查询文件 (默认读标准输入)
+  --output=FILE               结果文件 (默认写标准输出)
+  --paths                     点对点查询同时输出路径上的节点
+
+查询每行为 "s t" 或 "s t1 t2 ..." (一对多)，空行和 # 开头的行被忽略。
+每个查询输出一行距离，不可达为 -1；一对多查询按目标的顺序输出，--paths 时点对点查询在距离后输出路径节点。
+)";
+
+namespace {
+
+struct Options {
+    std::string engine = "bidir", weights = "int", graph, queries, output;
+    int threads = 0;
+    bool paths = false;
+};
+
+/**
+ * @brief 查询按 CSR 的方式展平：第 i 个查询为 nodes[offsets[i], offsets[i + 1])，第一个是起点，其余是终点。
+ */
+struct QueryBatch {
+    std::vector<std::size_t> offsets{0};
+    std::vector<int> nodes;
+
+    std::size_t size() const { return offsets.size() - 1; }
+};
+
+/**
+ * @brief 读入整个文件，path 为空时读标准输入。
+ */
+std::string read_all(const std::string &path) {
+    std::FILE *f = path.empty() ? stdin : std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error(path + ": cannot open");
+    std::string data;
+    char chunk[1 << 16];
+    for (std::size_t got; (got = std::fread(chunk, 1, sizeof(chunk), f)) > 0;) data.append(chunk, got);
+    bool failed = std::ferror(f);
+    if (f != stdin) std::fclose(f);
+    if (failed) throw std::runtime_error((path.empty() ? "stdin" : path) + ": read error");
+    return data;
+}
+
+QueryBatch parse_queries(const std::string &text, const std::string &name) {
+    QueryBatch batch;
+    const char *data = text.data();
+    std::size_t line_no = 0;
+    text_detail::for_each_line(data, 0, text.size(), [&](const char *p, const char *e) {
+        ++line_no;
+        p = text_detail::skip_blank(p, e);
+        if (p == e || *p == '#') return true;
+        int v;
+        while (text_detail::parse(p, e, v)) batch.nodes.push_back(v);
+        if (text_detail::skip_blank(p, e) != e || batch.nodes.size() - batch.offsets.back() < 2)
+            throw std::runtime_error(name + ": line " + std::to_string(line_no) + ": expected \"s t [t2 ...]\"");
+        batch.offsets.push_back(batch.nodes.size());
+        return true;
+    });
+    return batch;
+}
+
+/**
+ * @brief 追加式的文本缓冲区，用 to_chars 直接写入；clear 后保留容量，稳定后写出结果不再分配内存。
+ */
+struct LineWriter {
+    std::vector<char> buf;
+    std::size_t used = 0;
+
+    void clear() { used = 0; }
+
+    char *reserve(std::size_t bytes) {
+        if (used + bytes > buf.size()) buf.resize(std::max(buf.size() * 2, used + bytes));
+        return buf.data() + used;
+    }
+
+    void put(char c) { *reserve(1) = c, ++used; }
+
+    template <typename X>
+    void put(X x) {
+        char *p = reserve(32);  // 足够容纳 64 位整数和最短表示的 double
+        used = std::to_chars(p, p + 32, x).ptr - buf.data();
+    }
+
+    void flush(std::FILE *out) const {
+        if (used && std::fwrite(buf.data(), 1, used, out) != used) throw std::runtime_error("write error");
     }
+};
 
-    std::cout << "==========================================" << std::endl;
-
-    {
-        Dijkstra<int> d(7);
-        d.add_bidir_edge(0, 1, 2);
-        d.add_bidir_edge(0, 2, 6);
-        d.add_bidir_edge(1, 3, 5);
-        d.add_bidir_edge(2, 3, 8);
-        d.add_bidir_edge(3, 4, 10);
-        d.add_bidir_edge(3, 5, 15);
-        d.add_bidir_edge(4, 5, 3);
-        d.add_bidir_edge(4, 6, 2);
-        d.add_bidir_edge(5, 6, 6);
-        {
-            auto short_paths = d.dijkstra(0);
-            print_shortest_path(short_paths);
-        }
-        std::cout << "------------------------------------------" << std::endl;
-        {
-            auto short_paths = d.dijkstra(2);
-            print_shortest_path(short_paths);
-        }
+/**
+ * @brief 一对多查询：从 s 出发的一次 Dijkstra，所有目标都确定后停止。mark 为每个线程自己的时间戳数组，第一次使用时分配。
+ */
+template <typename T>
+void one_to_many(Dijkstra<T> &d, const int *q, std::size_t count, std::vector<std::uint32_t> &mark,
+                 std::uint32_t &stamp, LineWriter &out) {
+    auto &ws = thread_workspace<T, DefaultQueue<T>, 0, NoStats>();
+    if (mark.empty()) mark.assign(d.n, 0);
+    if (++stamp == 0) std::fill(mark.begin(), mark.end(), 0), stamp = 1;
+    std::size_t remaining = 0;
+    for (std::size_t i = 1; i < count; ++i)
+        if (d.check(q[i]) && mark[q[i]] != stamp) mark[q[i]] = stamp, ++remaining;
+    if (d.check(q[0]) && remaining)
+        d.search_until(q[0], ws, [&](int u) { return mark[u] == stamp && --remaining == 0; });
+    for (std::size_t i = 1; i < count; ++i) {
+        if (i > 1) out.put(' ');
+        bool ok = d.check(q[0]) && d.check(q[i]);
+        out.put(ok ? ws.get(q[i], T(-1)) : T(-1));  // 有效的起点总是已在工作区中
     }
-    std::cout << "==========================================" << std::endl;
-
-    {
-        BiDirDijkstra<int> d(7);
-        d.add_edge(0, 1, 2);
-        d.add_edge(0, 2, 6);
-        d.add_edge(1, 3, 5);
-        d.add_edge(2, 3, 8);
-        d.add_edge(3, 4, 10);
-        d.add_edge(3, 5, 15);
-        d.add_edge(4, 5, 3);
-        d.add_edge(4, 6, 2);
-        d.add_edge(5, 6, 6);
-        auto short_paths = d.dijkstra(0);
-        print_shortest_path(short_paths);
+    out.put('\n');
+}
+
+/**
+ * @brief 点对点查询，E 为任何提供 shortest_dist / shortest_path(s, t) 的引擎。引擎以 infinity 表示不可达，输出为 -1。
+ */
+template <typename T, typename E>
+void point_to_point(E &engine, int s, int t, bool paths, LineWriter &out) {
+    auto put_dist = [&](T d) { out.put(d == infinity<T>() ? T(-1) : d); };
+    if (!paths) {
+        put_dist(engine.shortest_dist(s, t));
+    } else {
+        auto [dist, path] = engine.shortest_path(s, t);
+        put_dist(dist);
+        for (const auto &[c, v] : path) out.put(' '), out.put(v);
     }
-    std::cout << "==========================================" << std::endl;
-
-    {
-        BiDirDijkstra<int> d(9);
-        d.add_edge(0, 1, 1);
-        d.add_edge(0, 5, 4);
-        d.add_edge(0, 4, 8);
-        d.add_edge(1, 2, 1);
-        d.add_edge(2, 3, 1);
-        d.add_edge(3, 7, 1);
-        d.add_edge(7, 8, 2);
-        d.add_edge(5, 8, 1);
-        d.add_edge(4, 6, 2);
-        d.add_edge(6, 8, 6);
-        auto short_paths = d.dijkstra(0);
-        print_shortest_path(short_paths);
+    out.put('\n');
+}
+
+/**
+ * @brief 第 p 百分位 (0 到 100)，v 会被部分排序。
+ */
+double percentile(std::vector<std::uint64_t> &v, double p) {
+    if (v.empty()) return 0;
+    auto k = std::min(v.size() - 1, static_cast<std::size_t>(p / 100 * v.size()));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return static_cast<double>(v[k]);
+}
+
+template <typename T, typename E>
+void run_queries(E &engine, Dijkstra<T> &tree, const QueryBatch &batch, const Options &opt, ThreadPool &pool,
+                 std::FILE *out) {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t BLOCK = 256;                           // 每个任务处理的查询数
+    const std::size_t per_round = std::size_t(pool.size()) * 16;  // 每轮的任务数，一轮结束后按顺序写出
+    const std::size_t blocks = (batch.size() + BLOCK - 1) / BLOCK;
+
+    std::vector<LineWriter> writers(std::min(per_round, blocks));
+    std::vector<std::vector<std::uint32_t>> marks(pool.size());
+    std::vector<std::uint32_t> stamps(pool.size(), 0);
+    std::vector<std::uint64_t> latency(batch.size());  // 每个查询的耗时 (ns)
+
+    auto start = Clock::now();
+    for (std::size_t first = 0; first < blocks; first += per_round) {
+        const std::size_t count = std::min(per_round, blocks - first);
+        pool.parallel_for(count, [&](std::size_t b, int worker) {
+            LineWriter &w = writers[b];
+            w.clear();
+            const std::size_t lo = (first + b) * BLOCK, hi = std::min(batch.size(), lo + BLOCK);
+            for (std::size_t i = lo; i < hi; ++i) {
+                const int *q = batch.nodes.data() + batch.offsets[i];
+                const std::size_t len = batch.offsets[i + 1] - batch.offsets[i];
+                auto t0 = Clock::now();
+                if (len == 2) point_to_point<T>(engine, q[0], q[1], opt.paths, w);
+                else one_to_many(tree, q, len, marks[worker], stamps[worker], w);
+                latency[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+            }
+        });
+        for (std::size_t b = 0; b < count; ++b) writers[b].flush(out);
     }
+    std::fflush(out);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::fprintf(stderr, "%zu queries, %d threads, %.3f s, %.0f queries/s, latency p50 %.1f us, p99 %.1f us\n",
+                 batch.size(), pool.size(), seconds, seconds > 0 ? batch.size() / seconds : 0.0,
+                 percentile(latency, 50) / 1e3, percentile(latency, 99) / 1e3);
 }
 
+template <typename T>
+int run(const Options &opt) {
+    using Clock = std::chrono::steady_clock;
+    ThreadPool pool(opt.threads > 0 ? opt.threads : std::max(1u, std::thread::hardware_concurrency()));
+
+    auto t0 = Clock::now();
+    const bool binary = opt.graph.ends_with(".csr");
+    MappedGraph<T> mg = binary ? map_csr_file<T>(opt.graph) : load_text_graph<T>(opt.graph, true, pool);
+    if (!mg.has_reverse) mg.reverse = reverse_graph(mg.forward);
+    QueryBatch batch = parse_queries(read_all(opt.queries), opt.queries.empty() ? "stdin" : opt.queries);
+
+    Dijkstra<T> tree(mg.forward);  // 一对多查询，点对点时也作为 dijkstra 引擎
+    tree.index_reachability = opt.engine == "dijkstra";  // 点对点查询先用可达性索引排除不可达的终点，一对多的搜索不使用
+    tree.finalize();
+    std::unique_ptr<BiDirDijkstra<T>> bidir;
+    std::unique_ptr<ContractionHierarchy<T>> ch;
+    if (opt.engine == "bidir") {
+        bidir = std::make_unique<BiDirDijkstra<T>>(mg.forward, mg.reverse);
+        bidir->index_reachability = true;
+        bidir->finalize();
+    } else if (opt.engine == "ch") {
+        ch = std::make_unique<ContractionHierarchy<T>>(mg.forward.n);
+        for (std::uint32_t u = 0; u < mg.forward.n; ++u)
+            for (const auto &[c, v] : mg.forward[u]) ch->add_edge(u, v, c);
+        ch->preprocess();
+    }
+    std::fprintf(stderr, "%d nodes, %zu arcs, %zu queries, prepared in %.3f s\n", mg.forward.n,
+                 mg.forward.edge_count(), batch.size(), std::chrono::duration<double>(Clock::now() - t0).count());
+
+    std::FILE *out = opt.output.empty() ? stdout : std::fopen(opt.output.c_str(), "wb");
+    if (!out) throw std::runtime_error(opt.output + ": cannot open");
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> closer(out == stdout ? nullptr : out, std::fclose);
+    if (bidir) run_queries<T>(*bidir, tree, batch, opt, pool, out);
+    else if (ch) run_queries<T>(*ch, tree, batch, opt, pool, out);
+    else run_queries<T>(tree, tree, batch, opt, pool, out);
+    return 0;
+}
+
+}  // namespace
+
 int main(int argc, char **argv) {
-    doctest::Context context;
-    context.applyCommandLine(argc, argv);
-    int res = context.run();  // run doctest
-    // important - query flags (and --exit) rely on the user doing this
-    if (context.shouldExit()) {
-        // propagate the result of the tests
-        return res;
+    Options opt;
+    bool ok = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--engine=", 0) == 0) opt.engine = arg.substr(9);
+        else if (arg.rfind("--weights=", 0) == 0) opt.weights = arg.substr(10);
+        else if (arg.rfind("--threads=", 0) == 0) opt.threads = std::atoi(arg.c_str() + 10);
+        else if (arg.rfind("--queries=", 0) == 0) opt.queries = arg.substr(10);
+        else if (arg.rfind("--output=", 0) == 0) opt.output = arg.substr(9);
+        else if (arg == "--paths") opt.paths = true;
+        else if (opt.graph.empty() && arg.rfind("--", 0) != 0) opt.graph = arg;
+        else ok = false;
+    }
+    if (!ok || opt.graph.empty() || (opt.weights != "int" && opt.weights != "double") ||
+        (opt.engine != "dijkstra" && opt.engine != "bidir" && opt.engine != "ch")) {
+        std::fputs(USAGE, stderr);
+        return 2;
     }
 
-    get_result();
-}
\ No newline at end of file
+    try {
+        return opt.weights == "int" ? run<int>(opt) : run<double>(opt);
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "shorthpath_run: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,77 @@
+#include <doctest/doctest.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/alt.h"
+#include "dijkstra/dijkstra.h"
+
+TEST_CASE("ALTTest") {
+    for (auto strategy : {ALT<int>::Strategy::Farthest, ALT<int>::Strategy::Avoid}) {
+        std::mt19937 rng(3);
+        const int n = 300;
+        Dijkstra<int> d(n);
+        ALT<int> alt(n, 4, strategy);
+        for (int i = 0; i < 1200; ++i) {
+            int u = rng() % n, v = rng() % n, c = rng() % 30 + 1;
+            d.add_edge(u, v, c);
+            alt.add_edge(u, v, c);
+        }
+
+        for (int i = 0; i < 200; ++i) {
+            std::uint32_t s = rng() % n, t = rng() % n;
+            auto expect = d.shortest_dist(s, t);
+            CHECK(alt.shortest_dist(s, t) == expect);
+            CHECK(alt.bidir_shortest_dist(s, t) == expect);
+
+            auto check_path = [&](const ALT<int>::P &ans) {
+                CHECK(ans.first == expect);
+                if (expect == ALT<int>::INF) return;
+                CHECK(ans.second.front() == ALT<int>::E(0, s));
+                CHECK(ans.second.back().second == t);
+                int sum = 0;
+                for (auto &e : ans.second) sum += e.first;
+                CHECK(sum == expect);
+            };
+            check_path(alt.shortest_path(s, t));
+            check_path(alt.bidir_shortest_path(s, t));
+        }
+    }
+
+    SUBCASE("起点终点越界 / 相同") {
+        ALT<int> alt(3);
+        alt.add_edge(0, 1, 1);
+        CHECK(alt.shortest_dist(0, 3) == ALT<int>::INF);
+        CHECK(alt.shortest_dist(2, 2) == 0);
+        CHECK(alt.shortest_dist(0, 2) == ALT<int>::INF);
+        CHECK(alt.bidir_shortest_dist(0, 1) == 1);
+    }
+}
+
+TEST_CASE("ALTSearchSpaceTest") {
+    // 网格图上的长距离查询，A* 确定的节点数应少于 Dijkstra
+    const int w = 100, n = w * w;
+    std::mt19937 rng(42);
+    Dijkstra<int> d(n);
+    ALT<int> alt(n, 8);
+    auto add = [&](int u, int v) {
+        int c = rng() % 100 + 1;
+        d.add_bidir_edge(u, v, c);
+        alt.add_edge(u, v, c), alt.add_edge(v, u, c);
+    };
+    for (int r = 0; r < w; ++r)
+        for (int c = 0; c < w; ++c) {
+            if (c + 1 < w) add(r * w + c, r * w + c + 1);
+            if (r + 1 < w) add(r * w + c, (r + 1) * w + c);
+        }
+
+    int s = w / 4 * w + w / 4, t = n - 1 - s;
+    Dijkstra<int>::Workspace ws, bws;
+    auto expect = d.shortest_dist(s, t, ws);
+    auto dijkstra_settled = ws.settled;
+    CHECK(alt.shortest_dist(s, t, ws) == expect);
+    CHECK(ws.settled < dijkstra_settled);
+    CHECK(alt.bidir_shortest_dist(s, t, ws, bws) == expect);
+    CHECK(ws.settled + bws.settled < dijkstra_settled);
+}
@@ -0,0 +1,227 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+
+TEST_CASE("BiDijkstraTest1") {
+    BiDirDijkstra<int> d(8);
+    d.add_edge(0, 1, 2);
+    d.add_edge(0, 2, 6);
+    d.add_edge(1, 3, 5);
+    d.add_edge(2, 3, 8);
+    d.add_edge(3, 4, 10);
+    d.add_edge(3, 5, 15);
+    d.add_edge(4, 5, 3);
+    d.add_edge(4, 6, 2);
+    d.add_edge(5, 6, 6);
+
+    SUBCASE("起点终点之间有边") {
+        auto ans = d.shortest_path(0, 5);
+        CHECK(ans.first == 20);
+    }
+    SUBCASE("起点终点之间没有边") {
+        auto ans = d.shortest_path(0, 7);
+        CHECK(ans.first == BiDirDijkstra<int>::INF);
+    }
+    SUBCASE("起点终点越界") {
+        auto ans = d.shortest_path(0, 9);
+        CHECK(ans.first == BiDirDijkstra<int>::INF);
+    }
+    SUBCASE("起点终点相同") {
+        auto ans = d.shortest_path(0, 0);
+        CHECK(ans.first == 0);
+    }
+    SUBCASE("所有结果") {
+        std::vector<BiDirDijkstra<int>::M> except_paths = {
+            {0, {{0, 0}}},
+            {2, {{0, 0}, {2, 1}}},
+            {6, {{0, 0}, {6, 2}}},
+            {7, {{0, 0}, {2, 1}, {5, 3}}},
+            {17, {{0, 0}, {2, 1}, {5, 3}, {10, 4}}},
+            {20, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}}},
+            {19, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {2, 6}}},
+            {BiDirDijkstra<int>::INF, {}},
+        };
+
+        auto tree = d.dijkstra(0);
+        REQUIRE(static_cast<std::size_t>(tree.size()) == except_paths.size());
+        for (std::uint32_t v = 0; v < tree.size(); ++v) CHECK(tree[v] == except_paths[v]);
+    }
+}
+
+TEST_CASE("BiDijkstraTest2") {
+    BiDirDijkstra<int> d(9);
+    d.add_edge(0, 1, 1);
+    d.add_edge(0, 5, 4);
+    d.add_edge(0, 4, 8);
+    d.add_edge(1, 2, 1);
+    d.add_edge(2, 3, 1);
+    d.add_edge(3, 7, 1);
+    d.add_edge(7, 8, 2);
+    d.add_edge(5, 8, 1);
+    d.add_edge(4, 6, 2);
+    d.add_edge(6, 8, 6);
+
+    SUBCASE("Test 所有路径") {
+        std::vector<BiDirDijkstra<int>::M> except_paths = {
+            {0, {{0, 0}}},
+            {1, {{0, 0}, {1, 1}}},
+            {2, {{0, 0}, {1, 1}, {1, 2}}},
+            {3, {{0, 0}, {1, 1}, {1, 2}, {1, 3}}},
+            {8, {{0, 0}, {8, 4}}},
+            {4, {{0, 0}, {4, 5}}},
+            {10, {{0, 0}, {8, 4}, {2, 6}}},
+            {4, {{0, 0}, {1, 1}, {1, 2}, {1, 3}, {1, 7}}},
+            {5, {{0, 0}, {4, 5}, {1, 8}}},
+        };
+
+        auto tree = d.dijkstra(0);
+        REQUIRE(static_cast<std::size_t>(tree.size()) == except_paths.size());
+        for (std::uint32_t v = 0; v < tree.size(); ++v) CHECK(tree[v] == except_paths[v]);
+    }
+}
+
+TEST_CASE("BiDijkstraQueuePolicyTest") {
+    std::mt19937 rng(11);
+    const int n = 300;
+    BiDirDijkstra<int, std::uint32_t, LazyBinaryHeap<int>> lazy(n);
+    BiDirDijkstra<int, std::uint32_t, IndexedDaryHeap<int, 4>> indexed(n);
+    BiDirDijkstra<int, std::uint32_t, BucketQueue<int>> dial(n);
+    BiDirDijkstra<int, std::uint32_t, RadixHeap<int>> radix(n);
+    for (int i = 0; i < 2000; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 20 + 1;
+        lazy.add_edge(u, v, c);
+        indexed.add_edge(u, v, c);
+        dial.add_edge(u, v, c);
+        radix.add_edge(u, v, c);
+    }
+
+    for (int i = 0; i < 50; ++i) {
+        int s = rng() % n, t = rng() % n;
+        auto expect = lazy.shortest_dist(s, t);
+        CHECK(indexed.shortest_dist(s, t) == expect);
+        CHECK(dial.shortest_dist(s, t) == expect);
+        CHECK(radix.shortest_dist(s, t) == expect);
+        CHECK(indexed.shortest_path(s, t).first == expect);
+        CHECK(radix.shortest_path(s, t).first == expect);
+    }
+}
+
+TEST_CASE("BiDijkstraOneToManyTest") {
+    std::mt19937 rng(17);
+    const int n = 3000;
+    BiDirDijkstra<int> d(n);
+    for (int i = 0; i < 12000; ++i) d.add_edge(rng() % n, rng() % n, rng() % 50 + 1);
+
+    auto all = d.dijkstra(0);
+    REQUIRE(all.size() == n);
+    for (int i = 0; i < 30; ++i) {
+        int t = rng() % n;
+        CHECK(all.dist[t] == d.shortest_dist(0, t));
+    }
+
+    std::vector<std::uint32_t> targets{5, 17, 5, n, 2999, 0};
+    auto some = d.shortest_paths(0, targets);
+    REQUIRE(some.size() == targets.size());
+    CHECK(some[0] == all[5]);
+    CHECK(some[1] == all[17]);
+    CHECK(some[2] == all[5]);
+    CHECK(some[3].first == BiDirDijkstra<int>::INF);  // 越界
+    CHECK(some[4] == all[2999]);
+    CHECK(some[5] == BiDirDijkstra<int>::M{0, {{0, 0}}});
+}
+
+TEST_CASE("BiDijkstraStatsTest") {
+    std::mt19937 rng(23);
+    const int n = 1000;
+    BiDirDijkstra<int> plain(n);
+    BiDirDijkstra<int, std::uint32_t, DefaultQueue<int>, TimedStats> timed(n);
+    for (int i = 0; i < 5000; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 30 + 1;
+        plain.add_edge(u, v, c);
+        timed.add_edge(u, v, c);
+    }
+
+    decltype(timed)::Workspace fw, bw;
+    for (int i = 0; i < 20; ++i) {
+        int s = rng() % n, t = rng() % n;
+        if (s == t) continue;
+        auto expect = plain.shortest_path(s, t);
+        CHECK(timed.shortest_path(s, t, fw, bw) == expect);
+
+        QueryStats total = fw.stats + bw.stats;
+        CHECK(total.settled == fw.settled + bw.settled);
+        CHECK(total.pops == total.settled + total.stale);
+        CHECK(total.pushes == total.relaxed + 2);
+        CHECK(total.relaxed <= total.scanned);
+        CHECK((total.meet_updates > 0) == (expect.first != BiDirDijkstra<int>::INF));
+        CHECK(fw.stats.time_ns(Phase::Search) > 0);
+        CHECK(bw.stats.time_ns(Phase::Search) == 0);  // 阶段耗时记在正向工作区
+
+        CHECK(timed.shortest_dist(s, t, fw, bw) == expect.first);
+        CHECK((fw.stats + bw.stats).pops == fw.stats.pops + bw.stats.pops);
+    }
+}
+
+TEST_CASE("BiDijkstraConcurrentTest") {
+    std::mt19937 rng(29);
+    const int n = 2000;
+    BiDirDijkstra<int> seq(n), par(n);
+    par.concurrent = true;
+    for (int i = 0; i < 8000; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 40 + 1;
+        seq.add_edge(u, v, c);
+        par.add_edge(u, v, c);
+    }
+    seq.add_edge(n - 1, n - 2, 0);  // 零权边
+    par.add_edge(n - 1, n - 2, 0);
+
+    // 并发搜索的相遇边可能不同，只检查路径是图中长度正确的路径
+    auto valid = [&](std::uint32_t s, std::uint32_t t, const BiDirDijkstra<int>::M &ans) {
+        if (ans.first == BiDirDijkstra<int>::INF) return ans.second.empty();
+        if (ans.second.empty() || ans.second.front().second != s || ans.second.back().second != t) return false;
+        int total = 0;
+        for (std::size_t i = 1; i < ans.second.size(); ++i) {
+            auto [c, v] = ans.second[i];
+            int u = ans.second[i - 1].second;
+            bool found = false;
+            for (const auto &[w, to] : par.g[u]) found = found || (to == v && w == c);
+            if (!found) return false;
+            total += c;
+        }
+        return total == ans.first;
+    };
+
+    BiDirDijkstra<int>::Workspace fw, bw;
+    for (int i = 0; i < 200; ++i) {
+        int s = rng() % n, t = rng() % n;
+        auto expect = seq.shortest_dist(s, t);
+        CHECK(par.shortest_dist(s, t, fw, bw) == expect);
+        auto ans = par.shortest_path(s, t, fw, bw);
+        CHECK(ans.first == expect);
+        CHECK(valid(s, t, ans));
+    }
+    CHECK(par.shortest_dist(0, n) == BiDirDijkstra<int>::INF);  // 越界
+    CHECK(par.shortest_path(3, 3).first == 0);
+}
+
+TEST_CASE("BiDijkstraConcurrentDoubleTest") {
+    std::mt19937 rng(31);
+    const int n = 500;
+    BiDirDijkstra<double> seq(n), par(n);
+    par.concurrent = true;
+    for (int i = 0; i < 1500; ++i) {
+        int u = rng() % n, v = rng() % n;
+        double c = (rng() % 40 + 1) * 0.25;  // 二进制可精确表示，求和顺序不影响结果
+        seq.add_edge(u, v, c);
+        par.add_edge(u, v, c);
+    }
+    for (int i = 0; i < 100; ++i) {
+        int s = rng() % n, t = rng() % n;
+        CHECK(par.shortest_dist(s, t) == seq.shortest_dist(s, t));
+    }
+}
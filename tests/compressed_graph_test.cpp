@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/compressed_graph.h"
+#include "dijkstra/dijkstra.h"
+
+namespace {
+
+template <typename G>
+std::vector<std::pair<int, int>> sorted_edges(const G &g, int u) {
+    std::vector<std::pair<int, int>> out;
+    for (const auto &[c, to] : g[u]) out.emplace_back(to, int(c));
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+}  // namespace
+
+TEST_CASE("GroupVarintTest") {
+    std::mt19937 rng(71);
+    std::vector<std::uint32_t> values;
+    for (int i = 0; i < 4000; ++i) values.push_back(rng() >> (rng() % 32));  // 1 到 4 个字节
+    values.push_back(0), values.push_back(~0u), values.push_back(255), values.push_back(256);
+    values.resize((values.size() + 3) / 4 * 4, 7);
+
+    std::vector<std::uint8_t> bytes;
+    for (std::size_t i = 0; i < values.size(); i += 4) group_varint::encode(values.data() + i, bytes);
+    bytes.resize(bytes.size() + group_varint::PADDING, 0);
+
+    for (bool simd : {false, true}) {
+        if (simd && !group_varint::ssse3_available()) continue;
+        const std::uint8_t *p = bytes.data();
+        std::vector<std::uint32_t> got(values.size());
+        for (std::size_t i = 0; i < values.size(); i += 4) p = group_varint::decode(p, got.data() + i, simd);
+        CHECK(got == values);
+        CHECK(p == bytes.data() + bytes.size() - group_varint::PADDING);
+    }
+}
+
+TEST_CASE("CompressedGraphTest") {
+    std::mt19937 rng(73);
+    const int n = 2000;
+    CSRBuilder<int> b(n);
+    for (int u = 0; u < n; ++u)
+        for (int k = 0; k < 3; ++k) b.add(u, std::clamp(u + int(rng() % 41) - 20, 0, n - 1), rng() % 1000);
+    for (int i = 0; i < 200; ++i) b.add(rng() % n, rng() % n, rng() % 60000);  // 远距离边和多重边
+    b.add(5, 5, 0);
+    auto g = b.build();
+
+    for (bool simd : {false, true}) {
+        CompressedGraph<int, std::uint16_t> cg(g);
+        cg.use_simd = simd && group_varint::ssse3_available();
+        CHECK(cg.edge_count() == g.edge_count());
+        for (int u = 0; u < n; ++u) {
+            CHECK(cg.degree(u) == g.degree(u));
+            CHECK(sorted_edges(cg, u) == sorted_edges(g, u));
+        }
+        auto back = cg.to_csr();
+        for (int u = 0; u < n; ++u) CHECK(sorted_edges(back, u) == sorted_edges(g, u));
+        // 编号局部性好的图：不到 CSR (目标 4 字节 + 边权 4 字节 + 偏移) 的 60%
+        CHECK(cg.memory_bytes() * 5 < (g.edge_count() * 8 + (n + 1) * 8) * 3);
+    }
+
+    SUBCASE("边权类型") {
+        CHECK_THROWS_AS((CompressedGraph<int, std::uint8_t>(g)), std::invalid_argument);  // 超出 uint8_t
+        CSRBuilder<int> neg(2);
+        neg.add(0, 1, -3);
+        CHECK_THROWS_AS((CompressedGraph<int, std::uint16_t>(neg.build())), std::invalid_argument);
+
+        CompressedGraph<int, std::uint8_t> q(g, 256, true);  // 量化为 256 的倍数
+        for (int u = 0; u < n; u += 7)
+            for (const auto &[c, to] : q[u]) CHECK(c % 256 == 0);
+
+        CSRBuilder<double> db(3);
+        db.add(0, 1, 0.1), db.add(1, 2, 0.5);
+        CHECK_THROWS_AS((CompressedGraph<double, float>(db.build())), std::invalid_argument);  // 0.1 不能用 float 精确表示
+        CompressedGraph<double, float> lossy(db.build(), 1.0, true);
+        CHECK(sorted_edges(lossy, 1) == std::vector<std::pair<int, int>>{{2, 0}});
+        CHECK((*lossy[1].begin()).first == 0.5);
+    }
+}
+
+TEST_CASE("CompressedEngineTest") {
+    std::mt19937 rng(79);
+    const int n = 1500;
+    using Packed = CompressedGraph<int, std::uint16_t>;
+    Dijkstra<int> plain(n);
+    Dijkstra<int, std::uint32_t, DefaultQueue<int>, NoStats, Packed> packed(n);
+    BiDirDijkstra<int, std::uint32_t, DefaultQueue<int>, NoStats, Packed> bidir(n);
+    auto add = [&](int u, int v, int c) {
+        plain.add_edge(u, v, c);
+        packed.add_edge(u, v, c);
+        bidir.add_edge(u, v, c);
+    };
+    for (int i = 0; i < 5000; ++i) add(rng() % n, rng() % n, rng() % 100);
+
+    auto run = [&] {
+        for (int i = 0; i < 200; ++i) {
+            int s = rng() % n, t = rng() % n;
+            auto expect = plain.shortest_dist(s, t);
+            CHECK(packed.shortest_dist(s, t) == expect);
+            CHECK(bidir.shortest_dist(s, t) == expect);
+            auto [dist, path] = packed.shortest_path(s, t);
+            CHECK(dist == expect);
+            CHECK(bidir.shortest_path(s, t).first == expect);
+            if (dist == Dijkstra<int>::INF) continue;
+            int sum = 0;
+            for (std::size_t k = 1; k < path.size(); ++k) sum += path[k].first;
+            CHECK(sum == dist);
+        }
+        int s = rng() % n;
+        CHECK(packed.dijkstra(s).dist == plain.dijkstra(s).dist);
+    };
+    run();
+    for (int i = 0; i < 300; ++i) add(rng() % n, rng() % n, rng() % 100);  // 冻结后继续加边
+    run();
+
+    Dijkstra<int, std::uint32_t, DefaultQueue<int>, NoStats, Packed> from_csr(plain.g);  // 由已有的 CSR 图编码
+    CHECK(from_csr.shortest_dist(0, 1) == plain.shortest_dist(0, 1));
+}
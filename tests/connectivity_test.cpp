@@ -0,0 +1,132 @@
+#include <doctest/doctest.h>
+
+#include <random>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/connectivity.h"
+#include "dijkstra/dijkstra.h"
+
+namespace {
+
+/**
+ * @brief 从 s 出发 BFS 得到的可达集合，作为参照。
+ */
+std::vector<char> bfs_reach(const CSRGraph<int> &g, int s) {
+    std::vector<char> seen(g.n, 0);
+    std::vector<int> queue{s};
+    seen[s] = 1;
+    for (std::size_t head = 0; head < queue.size(); ++head)
+        for (const auto &[c, to] : g[queue[head]])
+            if (!seen[to]) seen[to] = 1, queue.push_back(to);
+    return seen;
+}
+
+}  // namespace
+
+TEST_CASE("ConnectivityIndexTest") {
+    // 分量 {0, 1, 2} -> {3, 4} -> {5}，另有 {6} -> {5} 和孤立点 7
+    CSRBuilder<int> b(8);
+    b.add(0, 1, 1), b.add(1, 2, 1), b.add(2, 0, 1);
+    b.add(2, 3, 1), b.add(1, 3, 1);
+    b.add(3, 4, 1), b.add(4, 3, 1);
+    b.add(4, 5, 1), b.add(6, 5, 1);
+    ConnectivityIndex idx(b.build());
+
+    CHECK(idx.size() == 8);
+    CHECK(idx.component_count() == 5);
+    CHECK(idx.component[0] == idx.component[2]);
+    CHECK(idx.component[3] == idx.component[4]);
+    CHECK(idx.component[0] != idx.component[3]);
+    CHECK(idx.offsets.back() == 3);  // 0 -> 3 的两条边合并为一条
+
+    CHECK(idx.reachable(0, 5));
+    CHECK(idx.reachable(1, 0));
+    CHECK(idx.reachable(3, 5));
+    CHECK(!idx.reachable(3, 0));
+    CHECK(!idx.reachable(5, 4));
+    CHECK(!idx.reachable(6, 0));
+    CHECK(!idx.reachable(0, 6));
+    CHECK(!idx.reachable(0, 7));
+    CHECK(idx.reachable(7, 7));
+    CHECK(!idx.reachable(0, 8));  // 越界
+    CHECK(!idx.reachable(idx.NONE, 0));
+}
+
+TEST_CASE("ConnectivityIndexRandomTest") {
+    std::mt19937 rng(37);
+    for (int round = 0; round < 6; ++round) {
+        const int n = 300;
+        CSRBuilder<int> b(n);
+        // 稀疏的有向图，既有大的强连通分量也有大量单向可达的分量
+        for (int i = 0; i < n * (round + 2) / 2; ++i) b.add(rng() % n, rng() % n, 1);
+        auto g = b.build();
+        ConnectivityIndex idx(g);
+        for (int s = 0; s < n; s += 3) {
+            auto expect = bfs_reach(g, s);
+            for (int t = 0; t < n; ++t) CHECK(idx.reachable(s, t) == bool(expect[t]));
+        }
+    }
+}
+
+TEST_CASE("ConnectivityIndexDeepTest") {
+    // 很长的链和环，递归实现会栈溢出
+    const int n = 500000;
+    CSRBuilder<int> chain(n), ring(n);
+    for (int i = 0; i + 1 < n; ++i) chain.add(i, i + 1, 1), ring.add(i, i + 1, 1);
+    ring.add(n - 1, 0, 1);
+
+    ConnectivityIndex c(chain.build());
+    CHECK(c.component_count() == n);
+    CHECK(c.reachable(0, n - 1));
+    CHECK(!c.reachable(n - 1, 0));
+    CHECK(c.reachable(n / 2, n / 2 + 7));
+    CHECK(!c.reachable(n / 2 + 7, n / 2));
+
+    ConnectivityIndex r(ring.build());
+    CHECK(r.component_count() == 1);
+    CHECK(r.reachable(n - 1, 0));
+}
+
+TEST_CASE("ConnectivityEngineTest") {
+    std::mt19937 rng(41);
+    const int n = 2000;
+    Dijkstra<int> d(n), plain(n);
+    BiDirDijkstra<int> bd(n);
+    d.index_reachability = bd.index_reachability = true;  // 索引需要显式开启
+    for (int i = 0; i < 2600; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 20 + 1;
+        d.add_edge(u, v, c);
+        plain.add_edge(u, v, c);
+        bd.add_edge(u, v, c);
+    }
+    d.finalize();
+    plain.finalize();
+    CHECK(!d.reach.empty());
+    CHECK(plain.reach.empty());
+
+    Dijkstra<int>::Workspace ws;
+    BiDirDijkstra<int>::Workspace fw, bw;
+    int unreachable = 0;
+    for (int i = 0; i < 300; ++i) {
+        int s = rng() % n, t = rng() % n;
+        auto expect = plain.shortest_path(s, t);
+        CHECK(d.shortest_path(s, t, ws) == expect);
+        CHECK(d.shortest_dist(s, t, ws) == expect.first);
+        CHECK(bd.shortest_dist(s, t, fw, bw) == expect.first);
+        CHECK(bd.shortest_path(s, t, fw, bw).first == expect.first);
+        if (expect.first == Dijkstra<int>::INF) {  // 不可达的查询不做任何搜索
+            ++unreachable;
+            CHECK(ws.settled == 0);
+            CHECK(fw.settled + bw.settled == 0);
+        }
+    }
+    CHECK(unreachable > 0);
+
+    // 加边后索引随图重建
+    int s = 0, t = 1;
+    while (!d.unreachable(s, t)) ++t;
+    REQUIRE(t < n);
+    d.add_edge(s, t, 5);
+    CHECK(d.shortest_dist(s, t) == 5);
+}
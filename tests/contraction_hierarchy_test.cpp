@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/contraction_hierarchy.h"
+#include "dijkstra/dijkstra.h"
+
+TEST_CASE("ContractionHierarchyTest") {
+    ContractionHierarchy<int> ch(8);
+    ch.add_edge(0, 1, 2);
+    ch.add_edge(0, 2, 6);
+    ch.add_edge(1, 3, 5);
+    ch.add_edge(2, 3, 8);
+    ch.add_edge(3, 4, 10);
+    ch.add_edge(3, 5, 15);
+    ch.add_edge(4, 5, 3);
+    ch.add_edge(4, 6, 2);
+    ch.add_edge(5, 6, 6);
+
+    SUBCASE("起点终点之间有边") {
+        auto ans = ch.shortest_path(0, 5);
+        CHECK(ans.first == 20);
+        CHECK(ans.second == std::vector<ContractionHierarchy<int>::E>{{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}});
+    }
+    SUBCASE("起点终点之间没有边") {
+        CHECK(ch.shortest_path(0, 7).first == ContractionHierarchy<int>::INF);
+        CHECK(ch.shortest_dist(6, 0) == ContractionHierarchy<int>::INF);
+    }
+    SUBCASE("起点终点越界") { CHECK(ch.shortest_path(0, 9).first == ContractionHierarchy<int>::INF); }
+    SUBCASE("起点终点相同") { CHECK(ch.shortest_path(0, 0).first == 0); }
+}
+
+TEST_CASE("ContractionHierarchyRandomTest") {
+    std::mt19937 rng(5);
+    const int n = 400;
+    Dijkstra<int> d(n);
+    ContractionHierarchy<int> ch(n);
+    for (int i = 0; i < 1600; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 50 + 1;
+        d.add_edge(u, v, c);
+        ch.add_edge(u, v, c);
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        std::uint32_t s = rng() % n, t = rng() % n;
+        auto expect = d.shortest_dist(s, t);
+        CHECK(ch.shortest_dist(s, t) == expect);
+
+        // 展开后的路径必须由原图的边组成，且总长度等于最短距离
+        auto [dist, path] = ch.shortest_path(s, t);
+        CHECK(dist == expect);
+        if (dist == ContractionHierarchy<int>::INF) continue;
+        CHECK(path.front() == ContractionHierarchy<int>::E(0, s));
+        CHECK(path.back().second == t);
+        int sum = 0;
+        for (std::size_t k = 1; k < path.size(); ++k) {
+            bool found = false;
+            for (const auto &[c, to] : ch.g[path[k - 1].second]) found |= (to == path[k].second && c == path[k].first);
+            CHECK(found);
+            sum += path[k].first;
+        }
+        CHECK(sum == dist);
+    }
+}
+
+TEST_CASE("ContractionHierarchyCoreTest") {
+    // 幂律图：少数枢纽节点连接大量节点，收缩枢纽会产生平方级的捷径
+    std::mt19937 rng(17);
+    const int n = 3000;
+    Dijkstra<int> d(n);
+    CSRBuilder<int> edges(n);
+    std::vector<int> ends{0};
+    for (int v = 1; v < n; ++v)
+        for (int k = 0; k < 3; ++k) {
+            int u = ends[rng() % ends.size()], c = rng() % 50 + 1;
+            d.add_edge(u, v, c), d.add_edge(v, u, c);
+            edges.add(u, v, c), edges.add(v, u, c);
+            ends.push_back(u), ends.push_back(v);
+        }
+
+    auto check = [&](ContractionHierarchy<int> &ch, int queries) {
+        for (int i = 0; i < queries; ++i) {
+            int s = rng() % n, t = rng() % n;
+            auto expect = d.shortest_dist(s, t);
+            auto [dist, path] = ch.shortest_path(s, t);
+            CHECK(dist == expect);
+            int sum = 0;
+            for (std::size_t k = 1; k < path.size(); ++k) {
+                bool found = false;
+                for (const auto &[c, to] : ch.g[path[k - 1].second]) found |= (to == path[k].second && c == path[k].first);
+                CHECK(found);
+                sum += path[k].first;
+            }
+            CHECK(sum == dist);
+        }
+    };
+
+    SUBCASE("枢纽节点留在核心中") {
+        ContractionHierarchy<int> ch(n);
+        ch.pending = edges;
+        ch.core_degree_limit = 16;
+        ch.preprocess();
+        CHECK(ch.core > 0);
+        CHECK(ch.core < n / 2);
+        check(ch, 200);
+    }
+    SUBCASE("所有节点都是核心") {
+        ContractionHierarchy<int> ch(n);
+        ch.pending = edges;
+        ch.core_degree_limit = 0;
+        ch.preprocess();
+        CHECK(ch.core == n);
+        CHECK(ch.shortcut_count() == 0);
+        check(ch, 50);
+    }
+}
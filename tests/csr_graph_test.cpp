@@ -0,0 +1,61 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/csr_graph.h"
+
+TEST_CASE("CSRGraphTest") {
+    CSRBuilder<int> b(4);
+    b.add(0, 1, 5);
+    b.add(2, 3, 1);
+    b.add(0, 2, 7);
+    b.add(3, 0, 2);
+
+    auto g = b.build();
+    CHECK(g.edge_count() == 4);
+    CHECK(g.offsets == std::vector<std::size_t>{0, 2, 2, 3, 4});
+    CHECK(g.targets == std::vector<std::uint32_t>{1, 2, 3, 0});
+    CHECK(g.weights == std::vector<int>{5, 7, 1, 2});
+
+    SUBCASE("反向图") {
+        auto gr = b.build(nullptr, true);
+        CHECK(gr.offsets == std::vector<std::size_t>{0, 1, 2, 3, 4});
+        CHECK(gr.targets == std::vector<std::uint32_t>{3, 0, 0, 2});
+    }
+
+    SUBCASE("合并新边") {
+        CSRBuilder<int> more(4);
+        more.add(1, 3, 4);
+        more.add(0, 3, 9);
+        auto merged = more.build(&g);
+        std::vector<std::pair<int, std::uint32_t>> adj0;
+        for (const auto &[c, to] : merged[0]) adj0.emplace_back(c, to);
+        CHECK(adj0 == std::vector<std::pair<int, std::uint32_t>>{{5, 1}, {7, 2}, {9, 3}});
+        CHECK(merged.degree(1) == 1);
+        CHECK(merged.edge_count() == 6);
+    }
+}
+
+TEST_CASE("CSRArrayBorrowTest") {
+    auto data = std::make_shared<std::vector<int>>(std::vector<int>{3, 1, 4});
+    auto a = CSRArray<int>::borrow(data->data(), data->size(), data);
+    CHECK(a.borrowed());
+    CHECK(a.data() == data->data());
+
+    // 修改时复制，不影响被借用的内存
+    auto c = a;
+    c[1] = 5;
+    CHECK(!c.borrowed());
+    CHECK(c == std::vector<int>{3, 5, 4});
+    CHECK(*data == std::vector<int>{3, 1, 4});
+
+    // 拷贝只复制指针，keep 保持原数组存活
+    auto b = a;
+    CHECK(b.data() == data->data());
+    data.reset();
+    a = CSRArray<int>();
+    CHECK(b == std::vector<int>{3, 1, 4});
+}
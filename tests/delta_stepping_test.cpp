@@ -0,0 +1,46 @@
+#include <doctest/doctest.h>
+
+#include <random>
+#include <vector>
+
+#include "dijkstra/delta_stepping.h"
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/thread_pool.h"
+
+TEST_CASE("DeltaSteppingTest") {
+    std::mt19937 rng(9);
+    const int n = 2000;
+    Dijkstra<int> d(n);
+    Dijkstra<double> df(n);
+    DeltaStepping<int> ds(n);
+    DeltaStepping<double> dsf(n, 0.25);
+    ThreadPool four(4), three(3);
+    std::uniform_real_distribution<double> real(0.01, 1.0);
+    for (int i = 0; i < 8000; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 100 + 1;
+        double cf = real(rng);
+        d.add_edge(u, v, c), ds.add_edge(u, v, c);
+        df.add_edge(u, v, cf), dsf.add_edge(u, v, cf);
+    }
+
+    for (int s : {0, 123, 1999}) {
+        auto expect = d.dijkstra(s);
+        auto got = ds.distances(s, four);
+        REQUIRE(got.size() == static_cast<std::size_t>(expect.size()));
+        for (int v = 0; v < n; ++v) CHECK(got[v] == expect.dist[v]);
+
+        auto expect_f = df.dijkstra(s);
+        auto got_f = dsf.distances(s, three);
+        for (int v = 0; v < n; ++v) CHECK(got_f[v] == expect_f.dist[v]);  // 浮点距离逐位相同
+    }
+
+    SUBCASE("修改 delta 与线程数") {
+        ds.delta = 7;
+        ThreadPool one(1);
+        auto expect = d.dijkstra(5);
+        auto got = ds.distances(5, one);
+        for (int v = 0; v < n; ++v) CHECK(got[v] == expect.dist[v]);
+        CHECK(ds.distances(5) == got);  // 默认线程池
+        CHECK(ds.distances(n).empty());
+    }
+}
@@ -0,0 +1,344 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/dijkstra.h"
+
+TEST_CASE("DijkstraTest1") {
+    // 有向图
+    auto dijkstra = std::make_unique<Dijkstra<int>>(6);
+    dijkstra->add_edge(0, 1, 1);
+    dijkstra->add_edge(1, 2, 2);
+    dijkstra->add_edge(2, 3, 2);
+    dijkstra->add_edge(3, 4, 1);
+    dijkstra->add_edge(1, 3, 3);
+
+    SUBCASE("起点终点之间有边") {
+        auto ans = dijkstra->shortest_path(0, 4);
+        CHECK(ans.first == 5);
+    }
+    SUBCASE("起点终点之间没有边") {
+        auto ans = dijkstra->shortest_path(0, 5);
+        CHECK(ans.first == Dijkstra<int>::INF);
+    }
+    SUBCASE("起点终点越界") {
+        auto ans = dijkstra->shortest_path(0, 6);
+        CHECK(ans.first == Dijkstra<int>::INF);
+    }
+    SUBCASE("起点终点相同") {
+        auto ans = dijkstra->shortest_path(0, 0);
+        CHECK(ans.first == 0);
+    }
+    SUBCASE("所有结果") {
+        std::vector<Dijkstra<int>::P> except_paths = {
+            {0, {{0, 0}}},
+            {1, {{0, 0}, {1, 1}}},
+            {3, {{0, 0}, {1, 1}, {2, 2}}},
+            {4, {{0, 0}, {1, 1}, {3, 3}}},
+            {5, {{0, 0}, {1, 1}, {3, 3}, {1, 4}}},
+            {Dijkstra<int>::INF, {}},
+        };
+
+        auto tree = dijkstra->dijkstra(0);
+        REQUIRE(static_cast<std::size_t>(tree.size()) == except_paths.size());
+        for (std::uint32_t v = 0; v < tree.size(); ++v) CHECK(tree[v] == except_paths[v]);
+    }
+    SUBCASE("冻结后继续加边") {
+        dijkstra->finalize();
+        dijkstra->add_edge(4, 5, 2);
+        CHECK(dijkstra->shortest_dist(0, 5) == 7);
+        CHECK(dijkstra->shortest_dist(0, 4) == 5);
+    }
+}
+
+TEST_CASE("DijkstraTest2") {
+    Dijkstra<int> d(7);
+    d.add_bidir_edge(0, 1, 2);
+    d.add_bidir_edge(0, 2, 6);
+    d.add_bidir_edge(1, 3, 5);
+    d.add_bidir_edge(2, 3, 8);
+    d.add_bidir_edge(3, 4, 10);
+    d.add_bidir_edge(3, 5, 15);
+    d.add_bidir_edge(4, 5, 3);
+    d.add_bidir_edge(4, 6, 2);
+    d.add_bidir_edge(5, 6, 6);
+
+    SUBCASE("Test 起点1") {
+        auto ans = d.shortest_path(0, 6);
+        std::vector<Dijkstra<int>::P> except_paths = {
+            {0, {{0, 0}}},
+            {2, {{0, 0}, {2, 1}}},
+            {6, {{0, 0}, {6, 2}}},
+            {7, {{0, 0}, {2, 1}, {5, 3}}},
+            {17, {{0, 0}, {2, 1}, {5, 3}, {10, 4}}},
+            {20, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}}},
+            {19, {{0, 0}, {2, 1}, {5, 3}, {10, 4}, {2, 6}}},
+        };
+        auto tree = d.dijkstra(0);
+        REQUIRE(static_cast<std::size_t>(tree.size()) == except_paths.size());
+        for (std::uint32_t v = 0; v < tree.size(); ++v) CHECK(tree[v] == except_paths[v]);
+    }
+
+    SUBCASE("Test 起点2") {
+        std::vector<Dijkstra<int>::P> except_paths = {
+            {6, {{0, 2}, {6, 0}}},
+            {8, {{0, 2}, {6, 0}, {2, 1}}},
+            {0, {{0, 2}}},
+            {8, {{0, 2}, {8, 3}}},
+            {18, {{0, 2}, {8, 3}, {10, 4}}},
+            {21, {{0, 2}, {8, 3}, {10, 4}, {3, 5}}},
+            {20, {{0, 2}, {8, 3}, {10, 4}, {2, 6}}},
+        };
+
+        auto tree = d.dijkstra(2);
+        REQUIRE(static_cast<std::size_t>(tree.size()) == except_paths.size());
+        for (std::uint32_t v = 0; v < tree.size(); ++v) CHECK(tree[v] == except_paths[v]);
+    }
+}
+
+TEST_CASE("DijkstraQueuePolicyTest") {
+    std::mt19937 rng(7);
+    const int n = 300;
+    Dijkstra<int, std::uint32_t, LazyBinaryHeap<int>> lazy(n);
+    Dijkstra<int, std::uint32_t, IndexedDaryHeap<int, 4>> indexed(n);
+    Dijkstra<int, std::uint32_t, BucketQueue<int>> dial(n);
+    Dijkstra<int, std::uint32_t, RadixHeap<int>> radix(n);
+    for (int i = 0; i < 3000; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 20 + 1;
+        lazy.add_edge(u, v, c);
+        indexed.add_edge(u, v, c);
+        dial.add_edge(u, v, c);
+        radix.add_edge(u, v, c);
+    }
+
+    for (int s : {0, 17, 299}) {
+        CHECK(lazy.dijkstra(s) == indexed.dijkstra(s));
+        CHECK(lazy.shortest_path(s, 5) == indexed.shortest_path(s, 5));
+
+        // 单调队列中等距节点的顺序不同，只比较距离
+        auto expect = lazy.dijkstra(s);
+        auto by_dial = dial.dijkstra(s), by_radix = radix.dijkstra(s);
+        for (int v = 0; v < n; ++v) {
+            CHECK(by_dial.dist[v] == expect.dist[v]);
+            CHECK(by_radix.dist[v] == expect.dist[v]);
+        }
+        CHECK(dial.shortest_dist(s, 5) == lazy.shortest_dist(s, 5));
+        CHECK(radix.shortest_dist(s, 5) == lazy.shortest_dist(s, 5));
+    }
+}
+
+TEST_CASE("DijkstraStatsTest") {
+    std::mt19937 rng(19);
+    const int n = 500;
+    Dijkstra<int> plain(n);
+    Dijkstra<int, std::uint32_t, LazyBinaryHeap<int>, CountingStats> counted(n);
+    for (int i = 0; i < 3000; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 20 + 1;
+        plain.add_edge(u, v, c);
+        counted.add_edge(u, v, c);
+    }
+
+    decltype(counted)::Workspace ws;
+    CHECK(counted.dijkstra(0, ws).dist == plain.dijkstra(0).dist);
+    CHECK(ws.stats.settled == ws.settled);
+    CHECK(ws.stats.pops == ws.stats.settled + ws.stats.stale);
+    CHECK(ws.stats.pushes == ws.stats.relaxed + 1);
+    CHECK(ws.stats.pops == ws.stats.pushes);  // 搜索到底时队列被取空
+    CHECK(ws.stats.scanned <= counted.g.edge_count());
+    CHECK(ws.stats.time_ns(Phase::Search) == 0);  // CountingStats 不计时
+
+    CHECK(counted.shortest_dist(0, 7, ws) == plain.shortest_dist(0, 7));
+    CHECK(ws.stats.settled == ws.settled);
+}
+
+TEST_CASE("DistanceMatrixTest") {
+    std::mt19937 rng(13);
+    const int n = 500;
+    Dijkstra<int> d(n);
+    for (int i = 0; i < 2500; ++i) d.add_edge(rng() % n, rng() % n, rng() % 40 + 1);
+
+    std::vector<std::uint32_t> sources, targets;
+    for (int i = 0; i < 37; ++i) sources.push_back(rng() % n);
+    for (int i = 0; i < 23; ++i) targets.push_back(rng() % n);
+    sources.push_back(n);           // 越界
+    targets.push_back(d.NONE);      // 越界
+    targets.push_back(targets[0]);  // 重复
+
+    ThreadPool pool(3);
+    auto m = d.distance_matrix(sources, targets, pool);
+    REQUIRE(m.size() == sources.size() * targets.size());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+        for (std::size_t j = 0; j < targets.size(); ++j)
+            CHECK(m[i * targets.size() + j] == d.shortest_dist(sources[i], targets[j]));
+
+    CHECK(d.distance_matrix({}, targets, pool).empty());
+    CHECK(d.distance_matrix(sources, {}, pool).empty());
+
+    SUBCASE("多个线程同时使用默认线程池") {
+        std::vector<int> got[2];
+        std::thread a([&] { got[0] = d.distance_matrix(sources, targets); });
+        std::thread b([&] { got[1] = d.distance_matrix(sources, targets); });
+        a.join(), b.join();
+        CHECK(got[0] == m);
+        CHECK(got[1] == m);
+    }
+}
+
+TEST_CASE("DijkstraUpdateEdgeTest") {
+    std::mt19937 rng(61);
+    const int n = 300;
+    Dijkstra<int> d(n);
+    std::vector<std::pair<int, int>> arcs;
+    for (int i = 0; i < 1200; ++i) {
+        int u = rng() % n, v = rng() % n;
+        d.add_edge(u, v, rng() % 6);  // 小边权，大量等长路径和零权边
+        arcs.emplace_back(u, v);
+    }
+    std::vector<ShortestPathTree<int>> trees;
+    for (int s : {0, 7, 42}) trees.push_back(d.dijkstra(s));
+
+    for (int round = 0; round < 400; ++round) {
+        auto [u, v] = arcs[rng() % arcs.size()];
+        int cost = round % 3 == 0 ? rng() % 30 : rng() % 6;
+        CHECK(d.update_edge(u, v, cost, trees));
+        for (const auto &tree : trees) {
+            auto expect = Dijkstra<int>(d.g).dijkstra(tree.source);
+            CHECK(tree.dist == expect.dist);
+            for (std::uint32_t x = 0; x < n; ++x) {  // 前驱必须是图中的边且与距离一致
+                if (!tree.reached(x) || x == tree.source) continue;
+                auto [c, w] = tree.prev[x];
+                bool found = false;
+                for (const auto &[cost2, to] : d.g[w]) found = found || (to == x && cost2 == c);
+                CHECK(found);
+                CHECK(tree.dist[w] + c == tree.dist[x]);
+            }
+        }
+    }
+    int missing = 0;
+    while (std::find(arcs.begin(), arcs.end(), std::pair{0, missing}) != arcs.end()) ++missing;
+    auto before = trees;
+    CHECK(!d.update_edge(0, missing, 1, trees));  // 没有这条边时图和树都不变
+    CHECK(trees == before);
+}
+
+TEST_CASE("DijkstraUpdateEdgeLocalTest") {
+    // 长链 0 -> 1 -> ... -> n-1，外加 0 -> n-1 的长边
+    const int n = 10000;
+    Dijkstra<int> d(n);
+    for (int i = 0; i + 1 < n; ++i) d.add_edge(i, i + 1, 1);
+    d.add_edge(0, n - 1, 2 * n);
+    auto tree = d.dijkstra(0);
+    auto &ws = thread_workspace<int, DefaultQueue<int>>();
+
+    CHECK(d.update_edge(n - 3, n - 2, 5, tree));  // 变长只影响最后两个节点
+    CHECK(ws.settled <= 2);
+    CHECK(tree.dist[n - 2] == n + 2);
+    CHECK(tree.dist[n - 1] == n + 3);
+
+    CHECK(d.update_edge(n - 3, n - 2, 1, tree));  // 变短
+    CHECK(ws.settled <= 2);
+    CHECK(tree.dist[n - 1] == n - 1);
+
+    CHECK(d.update_edge(0, 1, 3 * n, tree));  // 整条链受影响，改走长边
+    CHECK(tree.dist[n - 1] == 2 * n);
+    CHECK(tree.prev[n - 1] == Dijkstra<int>::E{2 * n, 0});
+    CHECK(tree.dist[1] == 3 * n);
+    CHECK(!d.update_edge(1, 0, 1, tree));
+}
+
+TEST_CASE("DijkstraWithinTest") {
+    std::mt19937 rng(67);
+    const int n = 500;
+    Dijkstra<int> d(n);
+    for (int i = 0; i < 2000; ++i) d.add_edge(rng() % n, rng() % n, rng() % 10);
+
+    Dijkstra<int>::Workspace ws;
+    for (int round = 0; round < 20; ++round) {
+        int s = rng() % n, radius = rng() % 25;
+        auto tree = d.dijkstra(s);
+
+        std::vector<Dijkstra<int>::E> expect;
+        for (int v = 0; v < n; ++v)
+            if (tree.reached(v) && tree.dist[v] <= radius) expect.emplace_back(tree.dist[v], v);
+        auto got = d.within(s, radius, ws);
+        CHECK(std::is_sorted(got.begin(), got.end(), [](auto &a, auto &b) { return a.first < b.first; }));
+        std::sort(expect.begin(), expect.end());
+        auto sorted = got;
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted == expect);
+
+        // 最近的 k 个偶数节点：距离与完整搜索中第 k 小的偶数节点一致
+        std::vector<std::pair<int, int>> all;
+        for (int v = 0; v < n; v += 2)
+            if (tree.reached(v)) all.emplace_back(tree.dist[v], v);
+        std::sort(all.begin(), all.end());
+        auto near = d.k_nearest(s, 5, [](int v) { return v % 2 == 0; });
+        REQUIRE(near.size() == std::min<std::size_t>(5, all.size()));
+        for (std::size_t i = 0; i < near.size(); ++i) {
+            CHECK(near[i].first == all[i].first);
+            CHECK(near[i].second % 2 == 0);
+            CHECK(tree.dist[near[i].second] == near[i].first);
+        }
+    }
+
+    SUBCASE("多起点") {
+        std::vector<std::uint32_t> sources{3, 77, 3, d.NONE, 900};  // 重复和越界的起点被忽略
+        auto got = d.within(sources, 12);
+        std::vector<int> best(n, -1);
+        for (int s : {3, 77}) {
+            auto tree = d.dijkstra(s);
+            for (int v = 0; v < n; ++v)
+                if (tree.reached(v) && (best[v] == -1 || tree.dist[v] < best[v])) best[v] = tree.dist[v];
+        }
+        std::vector<Dijkstra<int>::E> expect;
+        for (int v = 0; v < n; ++v)
+            if (best[v] != -1 && best[v] <= 12) expect.emplace_back(best[v], v);
+        std::sort(expect.begin(), expect.end());
+        std::sort(got.begin(), got.end());
+        CHECK(got == expect);
+        CHECK(d.k_nearest(sources, 2, [](int) { return true; }).size() == 2);
+        CHECK(d.k_nearest(sources, 0, [](int) { return true; }).empty());
+    }
+}
+
+TEST_CASE("DijkstraWithinEarlyExitTest") {
+    // 长链上半径为 10 的查询只确定 12 个节点 (起点、10 个圈内节点和第一个圈外节点)
+    const int n = 100000;
+    Dijkstra<int> d(n);
+    for (int i = 0; i + 1 < n; ++i) d.add_edge(i, i + 1, 1);
+    Dijkstra<int>::Workspace ws;
+    auto got = d.within(0, 10, ws);
+    CHECK(got.size() == 11);
+    CHECK(got.back() == Dijkstra<int>::E{10, 10});
+    CHECK(ws.settled == 12);
+    CHECK(d.k_nearest(500, 3) == std::vector<Dijkstra<int>::E>{{0, 500}, {1, 501}, {2, 502}});
+    CHECK(d.within(0, -1).empty());
+}
+
+TEST_CASE("DijkstraNodeIdTest") {
+    // 64 位节点编号，不可达和越界都返回 infinity，起点的前驱为 no_node
+    Dijkstra<double, std::uint64_t> d(4);
+    d.add_edge(0, 1, 1.5);
+    d.add_edge(1, 2, 2.0);
+    CHECK(d.shortest_dist(0, 2) == 3.5);
+    CHECK(d.shortest_dist(0, 3) == infinity<double>());
+    CHECK(d.shortest_dist(0, std::uint64_t(1) << 40) == infinity<double>());
+    CHECK(d.shortest_path(2, 0).first == infinity<double>());
+    auto tree = d.dijkstra(0);
+    CHECK(tree.prev[0].second == no_node<std::uint64_t>());
+    CHECK(tree.dist[3] == infinity<double>());
+    CHECK(tree[2].second == std::vector<std::pair<double, std::uint64_t>>{{0, 0}, {1.5, 1}, {2.0, 2}});
+
+    // 无符号边权的不可达距离是类型的最大值，与任何实际距离都不同
+    Dijkstra<unsigned> u(3);
+    u.add_edge(0, 1, 7);
+    CHECK(u.shortest_dist(0, 1) == 7u);
+    CHECK(u.shortest_dist(0, 2) == infinity<unsigned>());
+    CHECK(u.shortest_path(0, 3).first == infinity<unsigned>());
+}
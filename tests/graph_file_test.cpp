@@ -0,0 +1,206 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/graph_file.h"
+
+namespace {
+
+std::string temp_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("shortpath_" + name)).string();
+}
+
+}  // namespace
+
+TEST_CASE("GraphFileTest") {
+    const int n = 200;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> node(0, n - 1), cost(1, 50);
+    CSRBuilder<int> b(n);
+    for (int i = 0; i < 1000; ++i) b.add(node(rng), node(rng), cost(rng));
+    auto forward = b.build(), reverse = b.build(nullptr, true);
+
+    const auto path = temp_path("graph_file_test.csr");
+    write_csr_file(path, forward, &reverse);
+
+    SUBCASE("映射后与原图一致") {
+        auto mg = map_csr_file<int>(path);
+        CHECK(mg.has_reverse);
+        CHECK(mg.forward.n == n);
+        CHECK(mg.forward.offsets.borrowed());
+        CHECK(mg.forward.targets.borrowed());
+        CHECK(std::equal(mg.forward.targets.begin(), mg.forward.targets.end(), forward.targets.begin()));
+        CHECK(std::equal(mg.forward.weights.begin(), mg.forward.weights.end(), forward.weights.begin()));
+        CHECK(std::equal(mg.reverse.offsets.begin(), mg.reverse.offsets.end(), reverse.offsets.begin()));
+        CHECK(std::equal(mg.reverse.targets.begin(), mg.reverse.targets.end(), reverse.targets.begin()));
+    }
+
+    SUBCASE("直接在映射的图上查询") {
+        Dijkstra<int> owned(n);
+        owned.pending = b;
+        owned.finalize();
+        auto mg = map_csr_file<int>(path);
+        Dijkstra<int> mapped(mg.forward);
+        BiDirDijkstra<int> bidir(mg.forward, mg.reverse);
+        CHECK(mapped.g.targets.borrowed());
+        for (int s = 0; s < n; s += 37)
+            for (int t = 0; t < n; t += 11) {
+                int expected = owned.shortest_dist(s, t);
+                CHECK(mapped.shortest_dist(s, t) == expected);
+                CHECK(bidir.shortest_dist(s, t) == expected);
+            }
+    }
+
+    SUBCASE("映射后追加边") {
+        auto mg = map_csr_file<int>(path);
+        Dijkstra<int> d(mg.forward);
+        d.add_edge(0, n - 1, 1);
+        CHECK(d.shortest_dist(0, n - 1) == 1);
+        CHECK(!d.g.targets.borrowed());
+    }
+
+    SUBCASE("映射后修改边权") {  // 只复制边权，拓扑仍借用文件
+        auto mg = map_csr_file<int>(path);
+        Dijkstra<int> d(mg.forward);
+        int u = 0;
+        while (mg.forward.degree(u) == 0) ++u;
+        int v = (*mg.forward[u].begin()).second;
+        CHECK(d.update_edge(u, v, 1000));
+        CHECK(d.g.offsets.borrowed());
+        CHECK(d.g.targets.borrowed());
+        CHECK(!d.g.weights.borrowed());
+    }
+
+    SUBCASE("只有正向图") {
+        write_csr_file(path, forward);
+        auto mg = map_csr_file<int>(path);
+        CHECK(!mg.has_reverse);
+        CHECK(mg.forward.edge_count() == forward.edge_count());
+    }
+
+    SUBCASE("边权类型不符") { CHECK_THROWS_AS(map_csr_file<double>(path), std::runtime_error); }
+
+    SUBCASE("64 位节点编号") {
+        CSRBuilder<int, std::uint64_t> wide(n);
+        for (int u = 0; u < n; ++u)
+            for (const auto &[c, v] : forward[u]) wide.add(u, v, c);
+        write_csr_file(path, wide.build());
+        CHECK_THROWS_AS(map_csr_file<int>(path), std::runtime_error);  // 编号宽度不符
+        auto mg = map_csr_file<int, std::uint64_t>(path);
+        CHECK(mg.forward.n == n);
+        CHECK(std::equal(mg.forward.targets.begin(), mg.forward.targets.end(), forward.targets.begin()));
+        Dijkstra<int, std::uint64_t> d(mg.forward);
+        Dijkstra<int> ref(forward);
+        for (int s = 0; s < n; s += 37)
+            for (int t = 0; t < n; t += 11) CHECK(d.shortest_dist(s, t) == ref.shortest_dist(s, t));
+    }
+
+    SUBCASE("文件损坏") {
+        {
+            std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(64 + 8);  // 正向图的 offsets[1]
+            std::uint64_t bad = ~0ull;
+            f.write(reinterpret_cast<const char *>(&bad), 8);
+        }
+        CHECK_THROWS_AS(map_csr_file<int>(path), std::runtime_error);
+        CHECK_NOTHROW(map_csr_file<int>(path, false));
+    }
+
+    SUBCASE("边数溢出") {  // m * 4 和 m * sizeof(int) 都回绕为 0，不能因此通过长度检查
+        {
+            std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(offsetof(CSRFileHeader, m));
+            std::uint64_t huge = 1ull << 62;
+            f.write(reinterpret_cast<const char *>(&huge), 8);
+        }
+        CHECK_THROWS_AS(map_csr_file<int>(path, false), std::runtime_error);
+    }
+
+    SUBCASE("不是 CSR 文件") {
+        std::ofstream(path) << "p sp 1 0\n";
+        CHECK_THROWS_AS(map_csr_file<int>(path), std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("ReadDimacsTest") {
+    std::istringstream in("c 示例\n"
+                          "p sp 3 3\n"
+                          "a 1 2 5\n"
+                          "a 2 3 7\n"
+                          "a 3 1 2\n");
+    auto b = read_dimacs<int>(in);
+    CHECK(b.n == 3);
+    auto g = b.build();
+    CHECK(g.offsets == std::vector<std::size_t>{0, 1, 2, 3});
+    CHECK(g.targets == std::vector<std::uint32_t>{1, 2, 0});
+    CHECK(g.weights == std::vector<int>{5, 7, 2});
+
+    std::istringstream bad("p sp 2 1\na 1 3 1\n");
+    CHECK_THROWS_AS(read_dimacs<int>(bad), std::runtime_error);
+    std::istringstream no_header("a 1 2 1\n");
+    CHECK_THROWS_AS(read_dimacs<int>(no_header), std::runtime_error);
+
+    SUBCASE("CRLF 换行和只有空白的行") {
+        std::istringstream crlf("c 示例\r\np sp 2 1\r\n\r\n   \t\na 1 2 5\r\n");
+        auto g2 = read_dimacs<int>(crlf).build();
+        CHECK(g2.targets == std::vector<std::uint32_t>{1});
+        CHECK(g2.weights == std::vector<int>{5});
+    }
+    SUBCASE("负的边数和边权") {
+        auto error = [](const std::string &text) {
+            std::istringstream in(text);
+            try {
+                read_dimacs<int>(in);
+            } catch (const std::runtime_error &e) {
+                return std::string(e.what());
+            }
+            return std::string();
+        };
+        CHECK(error("p sp 2 -1\n") == "DIMACS line 1: bad problem line");
+        CHECK(error("c\np sp 2 1\na 1 2 -3\n") == "DIMACS line 3: bad or negative arc weight");
+        std::istringstream wrapped("p sp 2 1\na 1 2 -3\n");  // 无符号边权不能回绕
+        CHECK_THROWS_AS(read_dimacs<unsigned>(wrapped), std::runtime_error);
+    }
+    SUBCASE("问题行的边数过大") {  // 只按上限预留，不按声明的边数分配
+        std::istringstream huge("p sp 10 999999999999\na 1 2 3\n");
+        auto g2 = read_dimacs<int>(huge).build();
+        CHECK(g2.targets == std::vector<std::uint32_t>{1});
+    }
+}
+
+TEST_CASE("ReadEdgeListTest") {
+    std::istringstream in("# u v w\n"
+                          "0 4 1.5\n"
+                          "\n"
+                          "4 2 0.25\n");
+    auto b = read_edge_list<double>(in);
+    CHECK(b.n == 5);
+    CHECK(b.size() == 2);
+
+    std::istringstream bad("0 1\n");
+    CHECK_THROWS_AS(read_edge_list<double>(bad), std::runtime_error);
+
+    std::istringstream negative("0 1 1\n1 2 -0.5\n");
+    try {
+        read_edge_list<double>(negative);
+        CHECK(false);
+    } catch (const std::runtime_error &e) {
+        CHECK(std::string(e.what()) == "edge list line 2: bad or negative edge weight");
+    }
+    std::istringstream wrapped("0 1 -3\n");  // 无符号边权不能回绕
+    CHECK_THROWS_AS(read_edge_list<unsigned>(wrapped), std::runtime_error);
+}
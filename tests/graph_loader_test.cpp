@@ -0,0 +1,176 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/graph_loader.h"
+
+namespace {
+
+std::string temp_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("shortpath_" + name)).string();
+}
+
+template <typename T>
+bool same_graph(const CSRGraph<T> &a, const CSRGraph<T> &b) {
+    return a.n == b.n && std::equal(a.offsets.begin(), a.offsets.end(), b.offsets.begin(), b.offsets.end()) &&
+           std::equal(a.targets.begin(), a.targets.end(), b.targets.begin(), b.targets.end()) &&
+           std::equal(a.weights.begin(), a.weights.end(), b.weights.begin(), b.weights.end());
+}
+
+}  // namespace
+
+TEST_CASE("ParallelBuildTest") {
+    const std::uint32_t n = 5000;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> node(0, n - 1), cost(1, 100);
+    CSRBuilder<int> all(n);
+    std::vector<CSRBuilder<int>> parts(7, CSRBuilder<int>(n));
+    for (int i = 0; i < 40000; ++i) {
+        int u = node(rng), v = node(rng), c = cost(rng);
+        all.add(u, v, c);
+        parts[i * parts.size() / 40000].add(u, v, c);
+    }
+    ThreadPool pool(4);
+    CHECK(same_graph(parallel_build(parts, n, false, pool), all.build()));
+    CHECK(same_graph(parallel_build(parts, n, true, pool), all.build(nullptr, true)));
+    CHECK(parallel_build(std::vector<CSRBuilder<int>>{}, 3u, false, pool).offsets == std::vector<std::size_t>{0, 0, 0, 0});
+}
+
+TEST_CASE("LoadTextGraphTest") {
+    ThreadPool pool(4);
+
+    SUBCASE("DIMACS，多块并行解析") {
+        const int n = 3000;
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> node(0, n - 1), cost(1, 1000);
+        CSRBuilder<int> expected(n);
+        const auto path = temp_path("loader_test.gr");
+        {
+            std::ofstream out(path);
+            out << "c 随机图\np sp " << n << " 30000\n";
+            for (int i = 0; i < 30000; ++i) {
+                int u = node(rng), v = node(rng), c = cost(rng);
+                expected.add(u, v, c);
+                out << "a " << u + 1 << ' ' << v + 1 << ' ' << c << '\n';
+            }
+        }
+        CHECK(std::filesystem::file_size(path) > 4 * text_detail::MIN_CHUNK_BYTES);
+        auto g = load_text_graph<int>(path, true, pool);
+        CHECK(g.has_reverse);
+        CHECK(same_graph(g.forward, expected.build()));
+        CHECK(same_graph(g.reverse, expected.build(nullptr, true)));
+
+        Dijkstra<int> ref(n);
+        ref.pending = expected;
+        BiDirDijkstra<int> bidir(std::move(g.forward), std::move(g.reverse));
+        for (int s = 0; s < n; s += 499)
+            for (int t = 0; t < n; t += 97) CHECK(bidir.shortest_dist(s, t) == ref.shortest_dist(s, t));
+        std::remove(path.c_str());
+    }
+
+    SUBCASE("CSV 边表") {
+        const auto path = temp_path("loader_test.csv");
+        std::ofstream(path) << "from,to,weight\r\n# 注释\r\n0,3,1.5\r\n3,1,0.25\r\n\r\n1,0,2\r\n";
+        auto g = load_text_graph<double>(path, false, pool);
+        CHECK(!g.has_reverse);
+        CHECK(g.forward.n == 4);
+        CHECK(g.forward.targets == std::vector<std::uint32_t>{3, 0, 1});
+        CHECK(g.forward.weights == std::vector<double>{1.5, 2, 0.25});
+        CHECK(Dijkstra<double>(g.forward).shortest_dist(0, 1) == 1.75);
+        std::remove(path.c_str());
+    }
+
+    SUBCASE("格式错误") {
+        const auto path = temp_path("loader_bad.gr");
+        std::ofstream(path) << "p sp 2 2\na 1 2 1\na 2 x 1\n";
+        try {
+            load_text_graph<int>(path, true, pool);
+            CHECK(false);
+        } catch (const std::runtime_error &e) {
+            CHECK(std::string(e.what()).find("line 3") != std::string::npos);
+        }
+        std::ofstream(path) << "p sp 2 1\na 1 3 1\n";
+        CHECK_THROWS_AS(load_text_graph<int>(path, true, pool), std::runtime_error);
+        std::ofstream(path) << "a 1 2 1\n";
+        CHECK_THROWS_AS(load_text_graph<int>(path, true, pool), std::runtime_error);
+        std::remove(path.c_str());
+
+        // 节点数会等于 no_node<V>()，与 read_edge_list 一样拒绝
+        const auto list = temp_path("loader_bad.txt");
+        std::ofstream(list) << "0 " << no_node<std::uint32_t>() - 1 << " 1\n";
+        CHECK_THROWS_AS(load_text_graph<int>(list, true, pool), std::runtime_error);
+        std::remove(list.c_str());
+    }
+
+    SUBCASE("负边权") {
+        const auto path = temp_path("loader_negative.gr");
+        std::ofstream(path) << "p sp 3 2\na 1 2 -5\na 2 3 4\n";
+        try {
+            load_text_graph<int>(path, true, pool);
+            CHECK(false);
+        } catch (const std::runtime_error &e) {
+            CHECK(std::string(e.what()).find("line 2") != std::string::npos);
+        }
+        const auto csv = temp_path("loader_negative.csv");
+        std::ofstream(csv) << "0,1,1\n1,2,-3\n";
+        CHECK_THROWS_AS(load_text_graph<double>(csv, true, pool), std::runtime_error);
+        CHECK_THROWS_AS(load_text_graph<unsigned>(csv, true, pool), std::runtime_error);
+        std::remove(path.c_str());
+        std::remove(csv.c_str());
+    }
+}
+
+TEST_CASE("LoadDimacsCoordinatesTest") {
+    const auto path = temp_path("loader_test.co");
+    std::ofstream(path) << "c 坐标\np aux sp co 3\nv 1 -73530767 41085396\nv 3 -73530538 41086098\n";
+    auto coords = load_dimacs_coordinates(path);
+    CHECK(coords.size() == 3);
+    CHECK(coords[0] == std::pair<double, double>{-73530767, 41085396});
+    CHECK(coords[1] == std::pair<double, double>{0, 0});
+    CHECK(coords[2] == std::pair<double, double>{-73530538, 41086098});
+
+    SUBCASE("节点数和编号越界") {
+        auto error = [&](const std::string &text, std::uint32_t max_nodes = no_node<std::uint32_t>() - 1) {
+            std::ofstream(path) << text;
+            try {
+                load_dimacs_coordinates(path, max_nodes);
+            } catch (const std::runtime_error &e) {
+                return std::string(e.what());
+            }
+            return std::string();
+        };
+        CHECK(error("p aux sp co 3\nv 4 0 0\n") == path + ": node id exceeds node count");
+        CHECK(error("p aux sp co 3\nv 2147483647 0 0\n") == path + ": node id exceeds node count");
+        CHECK(error("p aux sp co 999999999999\n") == path + ": node count exceeds graph");
+        CHECK(error("p aux sp co 3\nv 1 0 0\n", 2) == path + ": node count exceeds graph");
+        CHECK(error("v 1 0 0\n") == path + ": no DIMACS problem line");
+        CHECK(error("p aux sp co 3\nv 3 0 0\n", 3).empty());
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("ConvertToCSRFileTest") {
+    const auto input = temp_path("convert_test.gr"), output = temp_path("convert_test.csr");
+    std::ofstream(input) << "p sp 4 4\na 1 2 1\na 2 3 1\na 1 3 5\na 3 4 1\n";
+    auto [n, m] = convert_to_csr_file<int>(input, output);
+    CHECK(n == 4);
+    CHECK(m == 4);
+
+    auto mg = map_csr_file<int>(output);
+    BiDirDijkstra<int> d(mg.forward, mg.reverse);
+    CHECK(d.shortest_dist(0, 3) == 3);
+    CHECK(d.shortest_dist(3, 0) == d.INF);
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
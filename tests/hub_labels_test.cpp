@@ -0,0 +1,170 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/contraction_hierarchy.h"
+#include "dijkstra/hub_labels.h"
+
+TEST_CASE("HubLabelsTest") {
+    HubLabels<int> hl(8);
+    hl.add_edge(0, 1, 2);
+    hl.add_edge(0, 2, 6);
+    hl.add_edge(1, 3, 5);
+    hl.add_edge(2, 3, 8);
+    hl.add_edge(3, 4, 10);
+    hl.add_edge(3, 5, 15);
+    hl.add_edge(4, 5, 3);
+    hl.add_edge(4, 6, 2);
+    hl.add_edge(5, 6, 6);
+
+    SUBCASE("起点终点之间有边") {
+        auto ans = hl.shortest_path(0, 5);
+        CHECK(ans.first == 20);
+        CHECK(ans.second == std::vector<HubLabels<int>::E>{{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}});
+    }
+    SUBCASE("起点终点之间没有边") {
+        CHECK(hl.shortest_path(0, 7).first == HubLabels<int>::INF);
+        CHECK(hl.shortest_dist(6, 0) == HubLabels<int>::INF);
+    }
+    SUBCASE("起点终点越界") { CHECK(hl.shortest_path(0, 9).first == HubLabels<int>::INF); }
+    SUBCASE("起点终点相同") { CHECK(hl.shortest_path(0, 0).first == 0); }
+    SUBCASE("标签规模") {
+        hl.preprocess();
+        auto st = hl.stats();
+        CHECK(st.avg_out >= 1);
+        CHECK(st.avg_in >= 1);
+        CHECK(st.bytes == hl.out.memory_bytes() + hl.in.memory_bytes());
+        CHECK(st.bytes_per_node * 8 == double(st.bytes));
+    }
+}
+
+TEST_CASE("HubLabelsRandomTest") {
+    std::mt19937 rng(43);
+    const int n = 400;
+    BiDirDijkstra<int> bd(n);
+    ContractionHierarchy<int> ch(n);
+    for (int i = 0; i < 1400; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 50;  // 包含零权边
+        bd.add_edge(u, v, c);
+        ch.add_edge(u, v, c);
+    }
+    HubLabels<int> hl(ch);  // 复用收缩层次的顺序
+    CHECK(hl.built());
+    CHECK(hl.stats().avg_out < n);
+
+    for (int i = 0; i < 300; ++i) {
+        std::uint32_t s = rng() % n, t = rng() % n;
+        auto expect = bd.shortest_dist(s, t);
+        CHECK(hl.shortest_dist(s, t) == expect);
+
+        // 展开的路径必须由原图的边组成，且总长度等于最短距离
+        auto [dist, path] = hl.shortest_path(s, t);
+        CHECK(dist == expect);
+        if (dist == HubLabels<int>::INF) continue;
+        CHECK(path.front() == HubLabels<int>::E(0, s));
+        CHECK(path.back().second == t);
+        int sum = 0;
+        for (std::size_t k = 1; k < path.size(); ++k) {
+            bool found = false;
+            for (const auto &[c, to] : hl.g[path[k - 1].second]) found = found || (to == path[k].second && c == path[k].first);
+            CHECK(found);
+            sum += path[k].first;
+        }
+        CHECK(sum == dist);
+    }
+}
+
+TEST_CASE("HubLabelsFileTest") {
+    std::mt19937 rng(47);
+    const int n = 300;
+    HubLabels<double> hl(n);
+    for (int i = 0; i < 1000; ++i) hl.add_edge(rng() % n, rng() % n, (rng() % 64 + 1) * 0.5);
+
+    const std::string path = "hub_labels_test.hub";
+    write_hub_labels(path, hl);
+    auto loaded = read_hub_labels<double>(path);
+    CHECK(loaded.built());
+    CHECK(loaded.order == hl.order);
+    for (int i = 0; i < 200; ++i) {
+        int s = rng() % n, t = rng() % n;
+        CHECK(loaded.shortest_dist(s, t) == hl.shortest_dist(s, t));
+        CHECK(loaded.shortest_path(s, t) == hl.shortest_path(s, t));
+    }
+
+    CHECK_THROWS_AS(read_hub_labels<int>(path), std::runtime_error);  // 边权类型不符
+    {
+        std::FILE *f = std::fopen(path.c_str(), "r+b");
+        REQUIRE(f);
+        std::fseek(f, 64 + n * 4 + 8, SEEK_SET);  // 出标签 offsets[1]
+        std::uint64_t bad = ~std::uint64_t(0);
+        std::fwrite(&bad, 8, 1, f);
+        std::fclose(f);
+    }
+    CHECK_THROWS_AS(read_hub_labels<double>(path), std::runtime_error);
+
+    // 结构完好，但某个 parent 的标签中没有同一个枢纽，展开路径时会查找失败
+    write_hub_labels(path, hl);
+    std::size_t entry = 0;
+    std::uint32_t bad_parent = hl.NONE;
+    for (std::size_t i = 0; i < hl.out.hubs.size() && bad_parent == hl.NONE; ++i) {
+        if (hl.out.parent[i] == hl.NONE) continue;
+        for (int p = 0; p < n && bad_parent == hl.NONE; ++p)
+            if (hl.out.find(p, hl.out.hubs[i]) == -1) entry = i, bad_parent = p;
+    }
+    REQUIRE(bad_parent != hl.NONE);
+    {
+        std::FILE *f = std::fopen(path.c_str(), "r+b");
+        REQUIRE(f);
+        std::fseek(f, long(64 + n * 4 + (n + 1) * 8 + hl.out.hubs.size() * 4 + entry * 4), SEEK_SET);  // 出标签 parent[entry]
+        std::fwrite(&bad_parent, 4, 1, f);
+        std::fclose(f);
+    }
+    CHECK_THROWS_AS(read_hub_labels<double>(path), std::runtime_error);
+
+    // 两个节点经同一个枢纽互为 parent 且距离相等：距离检查能通过，但展开路径时会无限循环
+    write_hub_labels(path, hl);
+    const std::size_t entries = hl.out.hubs.size();
+    std::size_t a = 0;
+    while (hl.out.parent[a] == hl.NONE) ++a;
+    const auto b = static_cast<std::size_t>(hl.out.find(hl.out.parent[a], hl.out.hubs[a]));
+    int owner = 0;
+    while (hl.out.offsets[owner + 1] <= a) ++owner;
+    {
+        std::FILE *f = std::fopen(path.c_str(), "r+b");
+        REQUIRE(f);
+        const long parents = long(64 + n * 4 + (n + 1) * 8 + entries * 4), dists = long(parents + entries * 4);
+        std::fseek(f, long(parents + b * 4), SEEK_SET);  // parent[b] 指回 a 所在的节点
+        std::fwrite(&owner, 4, 1, f);
+        std::fseek(f, long(dists + a * 8), SEEK_SET);  // dist[a] = dist[b]
+        std::fwrite(&hl.out.dist[b], 8, 1, f);
+        std::fclose(f);
+    }
+    CHECK_THROWS_AS(read_hub_labels<double>(path), std::runtime_error);
+
+    // 头部的条数与文件大小不符时在分配之前拒绝
+    write_hub_labels(path, hl);
+    {
+        std::FILE *f = std::fopen(path.c_str(), "r+b");
+        REQUIRE(f);
+        std::fseek(f, long(offsetof(HubLabelFileHeader, out_entries)), SEEK_SET);
+        std::uint64_t huge = std::uint64_t(1) << 40;
+        std::fwrite(&huge, 8, 1, f);
+        std::fclose(f);
+    }
+    try {
+        read_hub_labels<double>(path);
+        CHECK(false);
+    } catch (const std::runtime_error &e) {
+        CHECK(std::string(e.what()).find("size does not match header") != std::string::npos);
+    }
+    std::remove(path.c_str());
+    CHECK_THROWS_AS(read_hub_labels<double>(path), std::runtime_error);  // 文件不存在
+}
@@ -0,0 +1,79 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/multi_source.h"
+
+namespace {
+
+template <typename T, int K>
+void check_against_dijkstra(int n, int m, int sources, std::mt19937 &rng) {
+    std::uniform_int_distribution<int> node(0, n - 1), cost(1, 100);
+    Dijkstra<T> ref(n);
+    MultiSourceDijkstra<T, K> ms(n);
+    for (int i = 0; i < m; ++i) {
+        int u = node(rng), v = node(rng);
+        T c = T(cost(rng)) / (std::is_floating_point_v<T> ? T(8) : T(1));
+        ref.add_edge(u, v, c);
+        ms.add_edge(u, v, c);
+    }
+    std::vector<std::uint32_t> src(sources);
+    for (auto &s : src) s = node(rng);
+    src.push_back(no_node<std::uint32_t>());  // 越界的起点
+
+    ThreadPool pool(3);
+    for (bool simd : {false, true}) {
+        ms.use_simd = simd;
+        auto got = ms.distances(src, pool);
+        REQUIRE(got.size() == src.size());
+        CHECK(got.back().empty());
+        for (int i = 0; i < sources; ++i) CHECK(got[i] == ref.dijkstra(src[i]).dist);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("MultiSourceDijkstraTest") {
+    std::mt19937 rng(17);
+    SUBCASE("int, K = 8") { check_against_dijkstra<int, 8>(300, 1500, 21, rng); }
+    SUBCASE("int, K = 16") { check_against_dijkstra<int, 16>(300, 900, 40, rng); }
+    SUBCASE("double, K = 8") { check_against_dijkstra<double, 8>(200, 1000, 11, rng); }
+    SUBCASE("float, K = 16") { check_against_dijkstra<float, 16>(200, 1000, 16, rng); }
+    SUBCASE("long long 使用标量内核") {
+        CHECK(!MultiSourceDijkstra<long long, 8>::simd_available());
+        check_against_dijkstra<long long, 8>(200, 1000, 9, rng);
+    }
+
+    SUBCASE("同一批中重复的起点") {
+        MultiSourceDijkstra<int> ms(3);
+        ms.add_edge(0, 1, 4);
+        ms.add_edge(1, 2, 1);
+        auto got = ms.distances({0, 0, 2});
+        CHECK(got[0] == std::vector<int>{0, 4, 5});
+        CHECK(got[1] == std::vector<int>{0, 4, 5});
+        CHECK(got[2] == std::vector<int>{ms.INF, ms.INF, 0});
+    }
+
+    SUBCASE("接近 INT32_MAX 的距离与 Dijkstra 一致") {
+        // 0 -> 1 的距离接近最大值，1 -> 2 溢出；两个内核都饱和为不可达而不回绕
+        const int big = std::numeric_limits<int>::max() - 10;
+        Dijkstra<int> ref(4);
+        MultiSourceDijkstra<int> ms(4);
+        for (auto [u, v, c] : std::vector<std::tuple<int, int, int>>{{0, 1, big}, {1, 2, 100}, {1, 3, 10}}) {
+            ref.add_edge(u, v, c);
+            ms.add_edge(u, v, c);
+        }
+        for (bool simd : {false, true}) {
+            ms.use_simd = simd;
+            auto got = ms.distances({0, 1, 0, 0, 0, 0, 0, 0});
+            CHECK(got[0] == std::vector<int>{0, big, ms.INF, ms.INF});
+            CHECK(got[0] == ref.dijkstra(0).dist);
+            CHECK(got[1] == std::vector<int>{ms.INF, 0, 100, 10});
+        }
+    }
+}
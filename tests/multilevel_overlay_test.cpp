@@ -0,0 +1,151 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/multilevel_overlay.h"
+
+namespace {
+
+/**
+ * @brief 检查路径由 g 的边组成，且总长度等于 dist。
+ */
+template <typename T>
+void check_path(const CSRGraph<T> &g, std::uint32_t s, std::uint32_t t, T dist,
+                const std::vector<std::pair<T, std::uint32_t>> &path) {
+    REQUIRE(!path.empty());
+    CHECK(path.front() == std::pair<T, std::uint32_t>{0, s});
+    CHECK(path.back().second == t);
+    T sum = 0;
+    for (std::size_t k = 1; k < path.size(); ++k) {
+        bool found = false;
+        for (const auto &[c, to] : g[path[k - 1].second]) found = found || (to == path[k].second && c == path[k].first);
+        CHECK(found);
+        sum += path[k].first;
+    }
+    CHECK(sum == dist);
+}
+
+}  // namespace
+
+TEST_CASE("MultilevelOverlayTest") {
+    MultilevelOverlay<int> mo(8, {2, 4});
+    mo.add_edge(0, 1, 2);
+    mo.add_edge(0, 2, 6);
+    mo.add_edge(1, 3, 5);
+    mo.add_edge(2, 3, 8);
+    mo.add_edge(3, 4, 10);
+    mo.add_edge(3, 5, 15);
+    mo.add_edge(4, 5, 3);
+    mo.add_edge(4, 6, 2);
+    mo.add_edge(5, 6, 6);
+
+    SUBCASE("起点终点之间有边") {
+        auto ans = mo.shortest_path(0, 5);
+        CHECK(ans.first == 20);
+        CHECK(ans.second == std::vector<MultilevelOverlay<int>::E>{{0, 0}, {2, 1}, {5, 3}, {10, 4}, {3, 5}});
+    }
+    SUBCASE("起点终点之间没有边") {
+        CHECK(mo.shortest_path(0, 7).first == MultilevelOverlay<int>::INF);
+        CHECK(mo.shortest_dist(6, 0) == MultilevelOverlay<int>::INF);
+    }
+    SUBCASE("起点终点越界") { CHECK(mo.shortest_path(0, 9).first == MultilevelOverlay<int>::INF); }
+    SUBCASE("起点终点相同") { CHECK(mo.shortest_path(0, 0).first == 0); }
+    SUBCASE("划分") {
+        mo.preprocess();
+        REQUIRE(mo.levels.size() == 2);
+        for (int v = 0; v < 8; ++v)  // 上层单元是下层单元的并
+            for (int w = 0; w < 8; ++w)
+                if (mo.levels[0].cell[v] == mo.levels[0].cell[w]) CHECK(mo.levels[1].cell[v] == mo.levels[1].cell[w]);
+        std::vector<int> size(mo.levels[0].cells, 0);
+        for (int v = 0; v < 8; ++v) ++size[mo.levels[0].cell[v]];
+        for (int c : size) CHECK(c <= 2);
+    }
+    SUBCASE("修改边权") {
+        CHECK(mo.set_weight(3, 5, 1));
+        CHECK(!mo.set_weight(5, 3, 1));
+        CHECK(mo.shortest_dist(0, 5) == 8);
+        CHECK(mo.shortest_dist(0, 6) == 14);
+    }
+    SUBCASE("修改边权后并发查询") {
+        // 修改后的第一次查询重新定制，其他同时到达的查询等待定制完成
+        CHECK(mo.set_weight(3, 5, 4));
+        std::vector<int> dist(4), cost(4);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&, i] { dist[i] = mo.shortest_dist(0, 5), cost[i] = mo.shortest_path(0, 6).first; });
+        for (auto &t : threads) t.join();
+        CHECK(dist == std::vector<int>(4, 11));
+        CHECK(cost == std::vector<int>(4, 17));
+        CHECK(!mo.dirty);
+    }
+}
+
+TEST_CASE("MultilevelOverlayRandomTest") {
+    std::mt19937 rng(53);
+    const int w = 24, n = w * w;
+    BiDirDijkstra<int> bd(n);
+    MultilevelOverlay<int> mo(n, {16, 64, 256});
+    auto add = [&](int u, int v, int c) {
+        bd.add_edge(u, v, c);
+        mo.add_edge(u, v, c);
+    };
+    // 网格上的单向和双向道路，加少量随机的远距离边
+    for (int y = 0; y < w; ++y)
+        for (int x = 0; x < w; ++x) {
+            int u = y * w + x;
+            if (x + 1 < w) add(u, u + 1, rng() % 20), rng() % 4 ? add(u + 1, u, rng() % 20) : void();
+            if (y + 1 < w) add(u, u + w, rng() % 20 + 1), rng() % 4 ? add(u + w, u, rng() % 20 + 1) : void();
+        }
+    for (int i = 0; i < 20; ++i) add(rng() % n, rng() % n, rng() % 100 + 1);
+    mo.preprocess();
+    CHECK(mo.levels.size() == 3);
+
+    auto run = [&](BiDirDijkstra<int> &ref) {
+        for (int i = 0; i < 200; ++i) {
+            int s = rng() % n, t = rng() % n;
+            auto expect = ref.shortest_dist(s, t);
+            CHECK(mo.shortest_dist(s, t) == expect);
+            auto [dist, path] = mo.shortest_path(s, t);
+            CHECK(dist == expect);
+            if (dist != MultilevelOverlay<int>::INF) check_path(mo.g, s, t, dist, path);
+        }
+    };
+    run(bd);
+
+    // 拓扑不变、边权整体变化后重新定制，划分保持不变
+    auto cells = mo.levels[0].cell;
+    std::vector<int> weights(mo.g.edge_count());
+    for (auto &c : weights) c = rng() % 30;
+    ThreadPool pool(3);
+    mo.update_weights(weights, pool);
+    CHECK(mo.levels[0].cell == cells);
+    BiDirDijkstra<int> changed(n);
+    for (int u = 0; u < n; ++u)
+        for (std::size_t i = mo.g.offsets[u]; i < mo.g.offsets[u + 1]; ++i) changed.add_edge(u, mo.g.targets[i], weights[i]);
+    run(changed);
+
+    CHECK_THROWS_AS(mo.update_weights(std::vector<int>(3, 1), pool), std::invalid_argument);
+}
+
+TEST_CASE("MultilevelOverlayDoubleTest") {
+    std::mt19937 rng(59);
+    const int n = 500;
+    BiDirDijkstra<double> bd(n);
+    MultilevelOverlay<double> mo(n, {24, 120});
+    for (int i = 0; i < 1500; ++i) {
+        int u = rng() % n, v = rng() % n;
+        double c = (rng() % 64 + 1) * 0.25;
+        bd.add_edge(u, v, c);
+        mo.add_edge(u, v, c);
+    }
+    for (int i = 0; i < 200; ++i) {
+        int s = rng() % n, t = rng() % n;
+        CHECK(mo.shortest_dist(s, t) == bd.shortest_dist(s, t));
+    }
+}
@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/priority_queue.h"
+
+TEST_CASE("PriorityQueueTest") {
+    IndexedDaryHeap<int, 4> q;
+    LazyBinaryHeap<int> lazy;
+    for (int u = 0; u < 10; ++u) {
+        q.push(100 - u, u);
+        lazy.push(100 - u, u);
+    }
+    q.push(50, 3);  // decrease-key
+    q.push(70, 3);  // 更大的键被忽略
+    lazy.push(50, 3);
+    CHECK(q.size() == 10);
+    CHECK(lazy.size() == 11);
+
+    std::vector<std::pair<int, std::uint32_t>> a, b;
+    while (!q.empty()) a.push_back(q.top()), q.pop();
+    while (!lazy.empty()) {
+        auto e = lazy.top();
+        lazy.pop();
+        if (!b.empty() && std::find_if(b.begin(), b.end(), [&](auto &x) { return x.second == e.second; }) != b.end())
+            continue;  // 过期元素
+        b.push_back(e);
+    }
+    CHECK(a == b);
+    CHECK(a.front() == std::pair<int, std::uint32_t>{50, 3});
+
+    SUBCASE("清空后复用") {
+        q.push(1, 2);
+        q.clear();
+        CHECK_FALSE(q.contains(2));
+        q.push(5, 7);
+        CHECK(q.top() == std::pair<int, std::uint32_t>{5, 7});
+    }
+}
+
+TEST_CASE("MonotoneQueueTest") {
+    auto drain = [](auto &q) {
+        std::vector<int> keys;
+        while (!q.empty()) {
+            keys.push_back(q.top().first);
+            auto [d, u] = q.top();
+            q.pop();
+            if (d < 40) q.push(d + (u % 7) * 3, u + 1);  // 单调地插入新键
+        }
+        return keys;
+    };
+    BucketQueue<int> dial;
+    RadixHeap<int> radix;
+    LazyBinaryHeap<int> lazy;
+    for (int u = 0; u < 20; ++u) {
+        dial.push(u * 5 % 17, u);
+        radix.push(u * 5 % 17, u);
+        lazy.push(u * 5 % 17, u);
+    }
+    auto a = drain(dial), b = drain(radix), c = drain(lazy);
+    CHECK(std::is_sorted(a.begin(), a.end()));
+    CHECK(a == c);
+    CHECK(b == c);
+
+    SUBCASE("桶队列扩容") {
+        BucketQueue<long long> q;
+        q.push(0, 0);
+        q.push(1000, 1);
+        q.push(70, 2);
+        CHECK(q.top().second == 0);
+        q.pop();
+        CHECK(q.top().first == 70);
+        q.pop();
+        q.push(5000, 3);
+        CHECK(q.top().first == 1000);
+        q.clear();
+        CHECK(q.empty());
+    }
+    SUBCASE("清空后插入很大的键不扩容") {
+        BucketQueue<long long> q;
+        q.push(3, 0);
+        q.clear();
+        q.push(1'000'000'000'000, 1);  // 例如 Dijkstra::repair 从远处的节点重新开始
+        q.push(1'000'000'000'007, 2);
+        CHECK(q.ring.size() == 64);
+        CHECK(q.top().second == 1);
+        q.pop();
+        CHECK(q.top().first == 1'000'000'000'007);
+        q.pop();
+        CHECK(q.empty());
+        q.push(10, 3);  // 队列为空时也可以插入比之前更小的键
+        q.push(4, 4);   // 非空时插入低于下界的键
+        q.push(40, 5);
+        CHECK(q.ring.size() == 64);
+        CHECK(q.top().first == 4);
+        q.pop();
+        CHECK(q.top().first == 10);
+    }
+
+    CHECK(std::is_same_v<DefaultQueue<int>, RadixHeap<int>>);
+    CHECK(std::is_same_v<DefaultQueue<double>, LazyBinaryHeap<double>>);
+}
@@ -0,0 +1,182 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/reorder.h"
+
+namespace {
+
+bool is_permutation_of_n(const NodeOrder<> &o, std::uint32_t n) {
+    if (o.size() != n) return false;
+    std::vector<std::uint32_t> seq = o.to_external;
+    std::sort(seq.begin(), seq.end());
+    for (std::uint32_t v = 0; v < n; ++v)
+        if (seq[v] != v || o.to_internal[o.to_external[v]] != v) return false;
+    return true;
+}
+
+/**
+ * @brief 按 order 编号后，所有边两端编号之差的最大值。
+ */
+int bandwidth(const CSRGraph<int> &g, const NodeOrder<> &o) {
+    int bw = 0;
+    for (std::uint32_t u = 0; u < g.n; ++u)
+        for (const auto &[c, to] : g[u]) bw = std::max(bw, std::abs(int(o.to_internal[u]) - int(o.to_internal[to])));
+    return bw;
+}
+
+}  // namespace
+
+TEST_CASE("NodeOrderTest") {
+    // 两个连通分量：0-3-1 与 2-4，另有孤立点 5
+    CSRBuilder<int> b(6);
+    b.add(0, 3, 1);
+    b.add(1, 3, 1);
+    b.add(4, 2, 1);
+    auto g = b.build();
+
+    CHECK(bfs_order(g).to_external == std::vector<std::uint32_t>{0, 3, 1, 2, 4, 5});
+    CHECK(dfs_order(g).to_external == std::vector<std::uint32_t>{0, 3, 1, 2, 4, 5});
+    auto rcm = rcm_order(g);
+    CHECK(is_permutation_of_n(rcm, 6));
+    CHECK(rcm.internal(6) == rcm.NONE);
+    CHECK(NodeOrder<>::identity(3).to_internal == std::vector<std::uint32_t>{0, 1, 2});
+
+    auto p = permute_graph(g, bfs_order(g));  // 0->0, 3->1, 1->2, 2->3, 4->4
+    CHECK(p.offsets == std::vector<std::size_t>{0, 1, 1, 2, 2, 3, 3});
+    CHECK(p.targets == std::vector<std::uint32_t>{1, 1, 3});
+}
+
+TEST_CASE("RCMBandwidthTest") {
+    // 网格的节点编号被打乱后，RCM 应当把带宽降回到网格宽度的量级
+    const int w = 30, n = w * w;
+    std::mt19937 rng(5);
+    std::vector<int> shuffle(n);
+    std::iota(shuffle.begin(), shuffle.end(), 0);
+    std::shuffle(shuffle.begin(), shuffle.end(), rng);
+    CSRBuilder<int> b(n);
+    for (int r = 0; r < w; ++r)
+        for (int c = 0; c < w; ++c) {
+            int u = shuffle[r * w + c];
+            if (c + 1 < w) b.add(u, shuffle[r * w + c + 1], 1), b.add(shuffle[r * w + c + 1], u, 1);
+            if (r + 1 < w) b.add(u, shuffle[(r + 1) * w + c], 1), b.add(shuffle[(r + 1) * w + c], u, 1);
+        }
+    auto g = b.build();
+    CHECK(bandwidth(g, NodeOrder<>::identity(n)) > n / 2);
+    CHECK(bandwidth(g, rcm_order(g)) <= 2 * w);
+    CHECK(bandwidth(g, bfs_order(g)) <= 2 * w);
+
+    std::vector<std::pair<double, double>> coords(n);
+    for (int r = 0; r < w; ++r)
+        for (int c = 0; c < w; ++c) coords[shuffle[r * w + c]] = {c, r};
+    auto hilbert = hilbert_order(coords);
+    CHECK(is_permutation_of_n(hilbert, n));
+    // Hilbert 曲线上相邻的两个点在网格上也相邻
+    int adjacent = 0;
+    for (int i = 0; i + 1 < n; ++i) {
+        auto [x0, y0] = coords[hilbert.to_external[i]];
+        auto [x1, y1] = coords[hilbert.to_external[i + 1]];
+        adjacent += std::abs(x0 - x1) + std::abs(y0 - y1) == 1;
+    }
+    CHECK(adjacent > n * 9 / 10);
+}
+
+TEST_CASE("ReorderedEngineTest") {
+    const int n = 400;
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> node(0, n - 1), cost(1, 20);
+    Dijkstra<int> d(n);
+    BiDirDijkstra<int> bd(n);
+    for (int i = 0; i < 2000; ++i) {
+        int u = node(rng), v = node(rng), c = cost(rng);
+        d.add_edge(u, v, c);
+        bd.add_edge(u, v, c);
+    }
+    d.finalize();
+
+    for (auto order : {bfs_order(d.g), dfs_order(d.g), rcm_order(d.g)}) {
+        auto rd = reorder(d, order);
+        auto rb = reorder(bd, order);
+        CHECK(rd.order.to_external != NodeOrder<>::identity(n).to_external);
+        for (std::uint32_t s = 0; s < n; s += 57) {
+            auto expected = d.dijkstra(s);
+            CHECK(rd.dijkstra(s).dist == expected.dist);
+            CHECK(rb.dijkstra(s).dist == expected.dist);
+            for (std::uint32_t t = 0; t < n; t += 13) {
+                CHECK(rd.shortest_dist(s, t) == expected.dist[t]);
+                CHECK(rb.shortest_dist(s, t) == expected.dist[t]);
+                auto path = rb.shortest_path(s, t);
+                CHECK(path.first == expected.dist[t]);
+                if (expected.reached(t)) {
+                    CHECK(path.second.front().second == s);
+                    CHECK(path.second.back().second == t);
+                }
+            }
+        }
+        std::vector<std::uint32_t> sources{0, 5, n}, targets{1, 2, 3, d.NONE};
+        CHECK(rd.distance_matrix(sources, targets) == d.distance_matrix(sources, targets));
+
+        // 一对多、等时圈和最近邻：距离相同的节点顺序可能不同，排序后比较
+        auto by_node = [](auto v) {
+            std::sort(v.begin(), v.end());
+            return v;
+        };
+        auto paths = rb.shortest_paths(3, targets);
+        auto expected_paths = bd.shortest_paths(3, targets);
+        REQUIRE(paths.size() == expected_paths.size());
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            CHECK(paths[i].first == expected_paths[i].first);
+            if (!paths[i].second.empty()) CHECK(paths[i].second.back().second == targets[i]);
+        }
+        std::vector<std::uint32_t> many{7, 11, n};
+        CHECK(by_node(rd.within(many, 15)) == by_node(d.within(many, 15)));
+        CHECK(by_node(rd.within(7, 15)) == by_node(d.within(7, 15)));
+        auto even = [](int v) { return v % 2 == 0; };
+        auto near = rd.k_nearest(many, 10, even);
+        auto expected_near = d.k_nearest(many, 10, even);
+        REQUIRE(near.size() == expected_near.size());
+        for (std::size_t i = 0; i < near.size(); ++i) {
+            CHECK(near[i].first == expected_near[i].first);
+            CHECK(even(near[i].second));
+        }
+        CHECK(rd.k_nearest(7, 5).size() == d.k_nearest(7, 5).size());
+    }
+    CHECK(reorder(d, NodeOrder<>::identity(n)).shortest_dist(0, n) == d.INF);
+    CHECK(reorder(d, NodeOrder<>::identity(n)).dijkstra(d.NONE).size() == 0);
+}
+
+TEST_CASE("ReorderedSettingsTest") {
+    const int n = 200;
+    std::mt19937 rng(13);
+    Dijkstra<int> d(n);
+    BiDirDijkstra<int> bd(n);
+    for (int i = 0; i < 300; ++i) {  // 稀疏，有不少不可达的点对
+        int u = rng() % n, v = rng() % n, c = rng() % 20 + 1;
+        d.add_edge(u, v, c);
+        bd.add_edge(u, v, c);
+    }
+    d.index_reachability = true;
+    bd.index_reachability = true;
+    bd.concurrent = true;
+
+    auto order = rcm_order(d.g);
+    auto rd = reorder(d, order);
+    auto rb = reorder(bd, order);
+    CHECK(rd.engine.index_reachability);
+    CHECK(!rd.engine.reach.empty());
+    CHECK(rb.engine.index_reachability);
+    CHECK(!rb.engine.reach.empty());
+    CHECK(rb.engine.concurrent);
+    for (int s = 0; s < n; s += 23)
+        for (int t = 0; t < n; t += 7) {
+            CHECK(rd.shortest_dist(s, t) == d.shortest_dist(s, t));
+            CHECK(rb.shortest_dist(s, t) == d.shortest_dist(s, t));
+        }
+}
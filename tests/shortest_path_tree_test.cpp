@@ -0,0 +1,38 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/shortest_path_tree.h"
+
+TEST_CASE("ShortestPathTreeTest") {
+    using Tree = ShortestPathTree<int>;
+    using E = Tree::E;
+    // 0 -1-> 1 -2-> 2，节点 3 不可达
+    struct FakeWorkspace {
+        std::vector<int> dist{0, 1, 3, 0};
+        std::vector<E> prev{{0, Tree::NONE}, {1, 0}, {2, 1}, {0, Tree::NONE}};
+        bool reached(std::uint32_t u) const { return u != 3; }
+    } ws;
+    Tree tree(0, 4, ws);
+
+    CHECK(tree.size() == 4);
+    CHECK(tree.reached(2));
+    CHECK_FALSE(tree.reached(3));
+    CHECK_FALSE(tree.reached(4));
+    CHECK(tree.dist[3] == Tree::INF);
+
+    std::vector<E> path{{9, 9}};
+    CHECK(tree.path_to(2, path) == 3);
+    CHECK(path == std::vector<E>{{0, 0}, {1, 1}, {2, 2}});
+    CHECK(tree.path_to(3, path) == Tree::INF);
+    CHECK(path.empty());
+
+    std::vector<E> backward(tree.walk(2).begin(), tree.walk(2).end());
+    CHECK(backward == std::vector<E>{{2, 2}, {1, 1}, {0, 0}});
+    CHECK(tree.walk(3).begin() == tree.walk(3).end());
+
+    CHECK(tree[0] == Tree::P{0, {{0, 0}}});
+    CHECK(tree[3].first == Tree::INF);
+}
@@ -0,0 +1,28 @@
+#include <doctest/doctest.h>
+
+#include "dijkstra/stats.h"
+
+TEST_CASE("StatsPolicyTest") {
+    static_assert(sizeof(NoStats) == 1 && !NoStats::enabled);
+
+    CountingStats c;
+    c.on_pop(false), c.on_settle(), c.on_scan(), c.on_scan(), c.on_relax(), c.on_push(), c.on_pop(true);
+    CHECK(c.pops == 2);
+    CHECK(c.stale == 1);
+    CHECK(c.settled == 1);
+    CHECK(c.scanned == 2);
+
+    QueryStats sum = c + c;
+    CHECK(sum.pops == 4);
+    c.reset();
+    CHECK(c.pops == 0);
+
+    TimedStats t;
+    {
+        auto timer = t.phase(Phase::Search);
+        volatile int x = 0;
+        for (int i = 0; i < 1000; ++i) x = x + i;
+    }
+    CHECK(t.time_ns(Phase::Search) > 0);
+    CHECK(t.time_ns(Phase::Path) == 0);
+}
@@ -0,0 +1,50 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "dijkstra/thread_pool.h"
+
+TEST_CASE("ThreadPoolTest") {
+    ThreadPool pool(4);
+    CHECK(pool.size() == 4);
+
+    for (std::size_t count : {0, 1, 3, 1000}) {
+        std::vector<std::atomic<int>> hits(count);
+        std::atomic<int> bad_worker{0};
+        pool.parallel_for(count, [&](std::size_t i, int worker) {
+            if (worker < 0 || worker >= pool.size()) ++bad_worker;
+            if (i % 97 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));  // 不均匀的任务
+            ++hits[i];
+        });
+        CHECK(bad_worker == 0);
+        CHECK(std::all_of(hits.begin(), hits.end(), [](auto &h) { return h == 1; }));
+    }
+}
+
+TEST_CASE("ThreadPoolExceptionTest") {
+    ThreadPool pool(4);
+    const std::size_t count = 1000;
+    // 0 号任务在调用线程上执行，最后一个任务在后台线程上执行
+    for (std::size_t bad : {std::size_t(0), count / 2, count - 1}) {
+        std::atomic<int> done{0};
+        CHECK_THROWS_AS(pool.parallel_for(count,
+                                          [&](std::size_t i, int) {
+                                              if (i == bad) throw std::runtime_error("task failed");
+                                              std::this_thread::sleep_for(std::chrono::microseconds(20));
+                                              ++done;
+                                          }),
+                        std::runtime_error);
+        CHECK(done < int(count));
+        CHECK(pool.running == 0);
+    }
+
+    // 异常之后线程池仍可正常使用
+    std::vector<std::atomic<int>> hits(count);
+    pool.parallel_for(count, [&](std::size_t i, int) { ++hits[i]; });
+    CHECK(std::all_of(hits.begin(), hits.end(), [](auto &h) { return h == 1; }));
+}
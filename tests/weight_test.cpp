@@ -0,0 +1,180 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dijkstra/alt.h"
+#include "dijkstra/bidirectional_dijkstra.h"
+#include "dijkstra/contraction_hierarchy.h"
+#include "dijkstra/delta_stepping.h"
+#include "dijkstra/dijkstra.h"
+#include "dijkstra/hub_labels.h"
+#include "dijkstra/multi_source.h"
+#include "dijkstra/multilevel_overlay.h"
+#include "dijkstra/thread_pool.h"
+#include "dijkstra/weight.h"
+
+TEST_CASE("WeightTest") {
+    static_assert(Weight<int> && Weight<unsigned> && Weight<std::uint64_t> && Weight<double>);
+    static_assert(!Weight<bool> && !Weight<std::pair<int, int>>);
+
+    CHECK(infinity<int>() == std::numeric_limits<int>::max());
+    CHECK(infinity<std::uint32_t>() == ~0u);
+    CHECK(infinity<double>() == std::numeric_limits<double>::infinity());
+
+    CHECK(saturating_add(3, 4) == 7);
+    CHECK(saturating_add(infinity<int>() - 1, 1) == infinity<int>());
+    CHECK(saturating_add(infinity<int>() - 1, 2) == infinity<int>());
+    CHECK(saturating_add(std::uint32_t(~0u - 10), std::uint32_t(100)) == infinity<std::uint32_t>());
+    CHECK(saturating_add(infinity<std::uint64_t>(), std::uint64_t(0)) == infinity<std::uint64_t>());
+    CHECK(saturating_add(0.5, 0.25) == 0.75);
+    CHECK(saturating_add(infinity<double>(), 1.0) == infinity<double>());
+}
+
+namespace {
+
+template <typename A>
+concept HasBidirALT = requires(A a) { a.bidir_shortest_dist(0, 1); };
+
+/**
+ * @brief 用 T 作为边权建同一张随机图，结果应与 int 边权一致。
+ */
+template <typename T>
+void check_engines() {
+    std::mt19937 rng(83);
+    const int n = 400;
+    Dijkstra<int> ref(n);
+    Dijkstra<T> dijkstra(n);
+    BiDirDijkstra<T> bidir(n);
+    ContractionHierarchy<T> ch(n);
+    HubLabels<T> hl(n);
+    MultilevelOverlay<T> mo(n, {16, 64});
+    ALT<T> alt(n, 4);
+    DeltaStepping<T> ds(n);
+    MultiSourceDijkstra<T, 4> ms(n);
+    for (int i = 0; i < 1600; ++i) {
+        int u = rng() % n, v = rng() % n, c = rng() % 50;
+        ref.add_edge(u, v, c);
+        dijkstra.add_edge(u, v, T(c));
+        bidir.add_edge(u, v, T(c));
+        ch.add_edge(u, v, T(c));
+        hl.add_edge(u, v, T(c));
+        mo.add_edge(u, v, T(c));
+        alt.add_edge(u, v, T(c));
+        ds.add_edge(u, v, T(c));
+        ms.add_edge(u, v, T(c));
+    }
+    auto want = [](int d) { return d == infinity<int>() ? infinity<T>() : T(d); };  // 不可达在各类型中都是 infinity
+    for (int i = 0; i < 200; ++i) {
+        int s = rng() % n, t = rng() % n;
+        T expect = want(ref.shortest_dist(s, t));
+        CHECK(dijkstra.shortest_dist(s, t) == expect);
+        CHECK(bidir.shortest_dist(s, t) == expect);
+        CHECK(bidir.shortest_path(s, t).first == expect);
+        CHECK(ch.shortest_dist(s, t) == expect);
+        CHECK(ch.shortest_path(s, t).first == expect);
+        CHECK(hl.shortest_dist(s, t) == expect);
+        CHECK(hl.shortest_path(s, t).first == expect);
+        CHECK(mo.shortest_dist(s, t) == expect);
+        CHECK(mo.shortest_path(s, t).first == expect);
+        CHECK(alt.shortest_dist(s, t) == expect);
+        if constexpr (std::is_signed_v<T>) CHECK(alt.bidir_shortest_dist(s, t) == expect);
+    }
+
+    ThreadPool pool(2);
+    std::vector<std::uint32_t> sources{0, 7, 42, 399};
+    auto batch = ms.distances(sources, pool);
+    for (std::size_t k = 0; k < sources.size(); ++k) {
+        auto tree = ref.dijkstra(sources[k]);
+        auto single = ds.distances(sources[k], pool);
+        for (int v = 0; v < n; ++v) {
+            T expect = tree.reached(v) ? T(tree.dist[v]) : infinity<T>();
+            CHECK(batch[k][v] == expect);
+            CHECK(single[v] == expect);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("WeightEngineTest") {
+    static_assert(HasBidirALT<ALT<int>> && HasBidirALT<ALT<double>>);
+    static_assert(!HasBidirALT<ALT<unsigned>>);  // 反向键为负，只支持有符号边权
+    check_engines<unsigned>();
+    check_engines<std::uint64_t>();
+    check_engines<double>();
+}
+
+TEST_CASE("WeightOverflowTest") {
+    using U = std::uint32_t;
+    const U big = ~0u - 10;
+    Dijkstra<U> dijkstra(4);
+    BiDirDijkstra<U> bidir(4);
+    for (auto [u, v, c] : std::vector<std::tuple<int, int, U>>{{0, 1, big}, {1, 2, 100}, {0, 3, 5}, {3, 2, 7}}) {
+        dijkstra.add_edge(u, v, c);
+        bidir.add_edge(u, v, c);
+    }
+
+    SUBCASE("溢出的路径不会回绕成短路径") {
+        CHECK(dijkstra.shortest_dist(1, 2) == 100);
+        CHECK(dijkstra.shortest_dist(0, 2) == 12);
+        CHECK(bidir.shortest_dist(0, 2) == 12);
+        CHECK(bidir.shortest_path(0, 2).second == std::vector<std::pair<U, std::uint32_t>>{{0, 0}, {5, 3}, {7, 2}});
+    }
+    SUBCASE("只有溢出的路径时不可达") {
+        Dijkstra<U> only(3);
+        BiDirDijkstra<U> only_bidir(3);
+        only.add_edge(0, 1, big), only.add_edge(1, 2, 100);
+        only_bidir.add_edge(0, 1, big), only_bidir.add_edge(1, 2, 100);
+        CHECK(only.shortest_dist(0, 1) == big);
+        CHECK(only.shortest_dist(0, 2) == infinity<U>());
+        CHECK(only.shortest_path(0, 2).second.empty());
+        CHECK(!only.dijkstra(0).reached(2));
+        CHECK(only_bidir.shortest_dist(0, 2) == infinity<U>());
+        CHECK(only_bidir.shortest_path(0, 2).second.empty());
+    }
+    SUBCASE("其余引擎") {
+        // 0 -> 1 -> 2 溢出，0 -> 3 -> 4 不溢出
+        const std::vector<std::tuple<int, int, U>> edges{{0, 1, big}, {1, 2, 100}, {0, 3, 5}, {3, 4, 7}};
+        ContractionHierarchy<U> ch(5);
+        HubLabels<U> hl(5);
+        MultilevelOverlay<U> mo(5, {2, 4});
+        ALT<U> alt(5, 2);
+        DeltaStepping<U> ds(5);
+        MultiSourceDijkstra<U, 4> ms(5);
+        for (auto [u, v, c] : edges) {
+            ch.add_edge(u, v, c), hl.add_edge(u, v, c), mo.add_edge(u, v, c), alt.add_edge(u, v, c);
+            ds.add_edge(u, v, c), ms.add_edge(u, v, c);
+        }
+        CHECK(ch.shortest_dist(0, 1) == big);
+        CHECK(hl.shortest_dist(0, 1) == big);
+        CHECK(mo.shortest_dist(0, 1) == big);
+        CHECK(alt.shortest_dist(0, 1) == big);
+        for (int t : {2, 4}) {
+            U expect = t == 2 ? infinity<U>() : U(12);
+            CHECK(ch.shortest_dist(0, t) == expect);
+            CHECK(ch.shortest_path(0, t).first == expect);
+            CHECK(hl.shortest_dist(0, t) == expect);
+            CHECK(hl.shortest_path(0, t).first == expect);
+            CHECK(mo.shortest_dist(0, t) == expect);
+            CHECK(mo.shortest_path(0, t).first == expect);
+            CHECK(alt.shortest_dist(0, t) == expect);
+        }
+        ThreadPool pool(2);
+        auto single = ds.distances(0, pool);
+        CHECK(single[1] == big);
+        CHECK(single[2] == infinity<U>());
+        CHECK(single[4] == 12);
+        CHECK(ds.delta == U((std::uint64_t(big) + 100 + 5 + 7) / 4));  // 平均边权，累加时不溢出
+        auto batch = ms.distances({0}, pool);
+        CHECK(batch[0][1] == big);
+        CHECK(batch[0][2] == infinity<U>());
+        CHECK(batch[0][4] == 12);
+        CHECK(ms.delta == ds.delta);  // 两个引擎选择相同的桶宽
+    }
+}
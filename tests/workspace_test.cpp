@@ -0,0 +1,27 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+
+#include "dijkstra/workspace.h"
+
+TEST_CASE("SearchWorkspaceTest") {
+    SearchWorkspace<int> ws;
+    ws.reset(4);
+    ws.set(1, 3, {3, 0});
+    CHECK(ws.reached(1));
+    CHECK(ws.get(1, -1) == 3);
+    CHECK(ws.get(2, -1) == -1);
+
+    ws.reset(4);  // 新一轮查询，旧值全部失效
+    CHECK_FALSE(ws.reached(1));
+    CHECK(ws.get(1, -1) == -1);
+
+    ws.reset(8);  // 扩容
+    ws.set(7, 1);
+    CHECK(ws.get(7, -1) == 1);
+
+    ws.generation = UINT32_MAX;  // 回绕
+    ws.reset(8);
+    CHECK(ws.generation == 1);
+    CHECK_FALSE(ws.reached(7));
+}
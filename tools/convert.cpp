@@ -0,0 +1,39 @@
+#include <cstdio>
+#include <exception>
+#include <string>
+
+#include "dijkstra/graph_loader.h"
+
+/**
+ * shortpath_convert：把 DIMACS .gr 或纯文本边表转换为可 mmap 的二进制 CSR 文件 (含反向图)。
+ */
+
+static const char *USAGE = R"(usage: shortpath_convert [--weights=int|double] INPUT OUTPUT
+  INPUT 以 .gr 结尾时按 DIMACS 格式解析，否则按 "u v w" 边表解析 (节点从 0 开始)
+)";
+
+int main(int argc, char **argv) {
+    std::string weights = "int", input, output;
+    bool ok = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--weights=", 0) == 0) weights = arg.substr(10);
+        else if (input.empty()) input = arg;
+        else if (output.empty()) output = arg;
+        else ok = false;
+    }
+    if (!ok || input.empty() || output.empty() || (weights != "int" && weights != "double")) {
+        std::fputs(USAGE, stderr);
+        return 2;
+    }
+
+    try {
+        auto [n, m] = weights == "int" ? convert_to_csr_file<int>(input, output)
+                                       : convert_to_csr_file<double>(input, output);
+        std::printf("%s: %d nodes, %zu arcs\n", output.c_str(), n, m);
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "shortpath_convert: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}